@@ -2,31 +2,42 @@
 #include <iostream>
 #include <exception>
 #include <string>
+#include <algorithm>
+#include "TargetPool.hpp"
 
 class Bureaucrat;
+class SignatureQuorum;
 
 class AForm {
 private:
-    const std::string name;
+    std::string name;
     bool is_signed;
-    const int grade_to_sign;
-    const int grade_to_execute;
+    int grade_to_sign;
+    int grade_to_execute;
+    mutable int ref_count;      // Owners through FormHandle
+    const SignatureQuorum *quorum;  // When set, signed once the quorum is reached
+
+    friend class FormHandle;
+    friend class SignatureQuorum;
+    friend class ExecutionCache;
 
 public:
     // Constructors
     AForm();
     AForm(const std::string _name, int _grade_to_sign, int _grade_to_execute);
     AForm(const AForm &src);
-    AForm &operator=(const AForm &src);
     
     // Destructor - virtual for proper polymorphism
     virtual ~AForm();
     
     // Getters
-    std::string getName() const;
+    const std::string &getName() const;
     bool getIsSigned() const;
+    bool requiresQuorum() const;
     int getGradeToSign() const;
     int getGradeToExecute() const;
+    virtual const std::string &getTarget() const = 0;
+    virtual TargetPool::Handle getTargetHandle() const = 0;
     
     // Member functions
     void beSigned(const Bureaucrat &bureaucrat);
@@ -34,6 +45,9 @@ public:
     // Pure virtual function - makes this an abstract class
     virtual void execute(Bureaucrat const &executor) const = 0;
     
+    // Executes the form and reports whether its action succeeded
+    virtual bool perform(Bureaucrat const &executor) const;
+    
     // Exceptions
     class GradeTooHighException : public std::exception {
     public:
@@ -49,10 +63,22 @@ public:
     public:
         virtual const char *what() const throw();
     };
+    
+    class QuorumRequiredException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
 
 protected:
+    // Only the concrete forms assign, each from its own type, so a form
+    // never takes the name and grades of a different form type
+    AForm &operator=(const AForm &src);
+    
     // Protected method to check execution requirements
     void checkExecution(const Bureaucrat &executor) const;
+    
+    // Exchange the base part of two forms, used by the concrete swaps
+    void swap(AForm &other);
 };
 
 std::ostream &operator<<(std::ostream &out, const AForm &src);
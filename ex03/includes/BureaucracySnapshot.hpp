@@ -0,0 +1,98 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+class AForm;
+class Bureaucrat;
+
+// Read-only, mmap-able image of a roster and its pending forms.
+// The file is a header, two fixed-size record arrays and a table of
+// interned strings. Opening it only maps the file; records are checked
+// one page at a time the first time they are read.
+class BureaucracySnapshot {
+private:
+    struct Header {
+        char magic[8];
+        uint32_t bureaucrat_count;
+        uint32_t form_count;
+        uint64_t bureaucrat_offset;
+        uint64_t form_offset;
+        uint64_t strings_offset;
+        uint64_t strings_size;
+    };
+
+    struct BureaucratRecord {
+        uint32_t name_offset;
+        uint32_t name_length;
+        int32_t grade;
+    };
+
+    struct FormRecord {
+        uint32_t target_offset;
+        uint32_t target_length;
+        uint8_t type_id;
+        uint8_t is_signed;
+        uint8_t grade_to_sign;
+        uint8_t grade_to_execute;
+    };
+
+    static const size_t PAGE_SIZE = 4096;
+
+    const char *data;
+    size_t size;
+    const Header *header;
+    std::vector<bool> checked_bureaucrat_pages;
+    std::vector<bool> checked_form_pages;
+
+    void checkString(uint32_t offset, uint32_t length) const;
+    const BureaucratRecord &bureaucratRecord(size_t index);
+    const FormRecord &formRecord(size_t index);
+    void unmap();
+
+    // Non-copyable: owns the mapping
+    BureaucracySnapshot(const BureaucracySnapshot &src);
+    BureaucracySnapshot &operator=(const BureaucracySnapshot &src);
+
+public:
+    // Constructors
+    BureaucracySnapshot(const std::string &path);
+
+    // Destructor
+    ~BureaucracySnapshot();
+
+    // Writing
+    static void save(const std::string &path, const std::vector<Bureaucrat *> &roster,
+                     const std::vector<AForm *> &forms);
+
+    // Roster access
+    size_t getBureaucratCount() const;
+    std::string getBureaucratName(size_t index);
+    int getBureaucratGrade(size_t index);
+    Bureaucrat *makeBureaucrat(size_t index);
+
+    // Form access
+    size_t getFormCount() const;
+    int getFormTypeId(size_t index);
+    std::string getFormTarget(size_t index);
+    bool getFormIsSigned(size_t index);
+    AForm *makeForm(size_t index);
+
+    // Exceptions
+    class FileException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class CorruptSnapshotException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class IndexOutOfRangeException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
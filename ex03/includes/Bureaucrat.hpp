@@ -2,14 +2,21 @@
 #include <iostream>
 #include <exception>
 #include <string>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
 
 class AForm;
+class ExecutionQueue;
+struct ExecutionTicket;
+struct FormDescriptor;
 
 class Bureaucrat {
-public:
-    const std::string name;
+private:
+    std::string name;
     int grade;
-    
+
+public:
     // Constructors
     Bureaucrat();
     Bureaucrat(const std::string _name, int _grade);
@@ -20,17 +27,23 @@ public:
     ~Bureaucrat();
     
     // Getters
-    std::string getName() const;
+    const std::string &getName() const;
     int getGrade() const;
     
     // Setters
     void setGrade(int _grade);
     
     // Member functions
+    void swap(Bureaucrat &other);
     void incrementGrade();
     void decrementGrade();
     void signForm(AForm &form);
+    bool signForms(const std::vector<AForm *> &forms, std::vector<std::string> &reasons);
     void executeForm(AForm const &form) const;
+    void signForm(FormDescriptor &form);
+    void executeForm(FormDescriptor const &form) const;
+    bool performForm(AForm const &form) const;
+    ExecutionTicket executeFormAsync(AForm const &form, ExecutionQueue &queue) const;
     
     // Exceptions
     class GradeTooHighException : public std::exception {
@@ -45,3 +58,13 @@ public:
 };
 
 std::ostream &operator<<(std::ostream &out, const Bureaucrat &src);
+
+// Cheap swap for containers and algorithms (no string copies)
+void swap(Bureaucrat &a, Bureaucrat &b);
+
+namespace std {
+    template <>
+    inline void swap<Bureaucrat>(Bureaucrat &a, Bureaucrat &b) {
+        a.swap(b);
+    }
+}
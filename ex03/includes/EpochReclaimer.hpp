@@ -0,0 +1,95 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <vector>
+
+class AForm;
+
+// Epoch-based reclamation for objects shared with concurrent readers.
+// Readers announce the epoch they run in (one store and a barrier);
+// retired objects wait in the limbo list of their epoch and are freed in
+// a batch once every active reader has moved two epochs past it.
+class EpochReclaimer {
+public:
+    static const int MAX_READERS = 64;
+
+    typedef void (*Deleter)(void *object);
+
+    // Keeps a reader inside an epoch for the lifetime of the guard
+    class Guard {
+    private:
+        EpochReclaimer &reclaimer;
+        int slot;
+
+        Guard(const Guard &src);
+        Guard &operator=(const Guard &src);
+
+    public:
+        Guard(EpochReclaimer &_reclaimer, int _slot);
+        ~Guard();
+    };
+
+private:
+    struct ReaderSlot {
+        volatile unsigned long epoch;
+        volatile int active;
+        volatile int in_use;
+        char padding[64 - sizeof(unsigned long) - 2 * sizeof(int)];
+    };
+
+    struct Retired {
+        void *object;
+        Deleter deleter;
+    };
+
+    static const int EPOCH_COUNT = 3;
+
+    volatile unsigned long global_epoch;
+    ReaderSlot readers[MAX_READERS];
+    std::vector<Retired> limbo[EPOCH_COUNT];
+    volatile int lock;
+    unsigned long reclaimed;
+
+    void acquireLock();
+    void releaseLock();
+    static void freeAll(std::vector<Retired> &objects);
+    static void deleteForm(void *object);
+
+    // Non-copyable: readers keep slot indexes into this object
+    EpochReclaimer(const EpochReclaimer &src);
+    EpochReclaimer &operator=(const EpochReclaimer &src);
+
+public:
+    // Constructors
+    EpochReclaimer();
+
+    // Destructor - frees everything still retired; no reader may be active
+    ~EpochReclaimer();
+
+    // Getters
+    unsigned long getEpoch() const;
+    size_t getPendingCount();
+    unsigned long getReclaimedCount() const;
+
+    // Readers
+    int registerReader();
+    void unregisterReader(int slot);
+    void enter(int slot);
+    void leave(int slot);
+
+    // Writers
+    void retire(AForm *form);
+    void retire(void *object, Deleter deleter);
+    size_t tryReclaim();
+
+    // Exceptions
+    class TooManyReadersException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class InvalidSlotException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
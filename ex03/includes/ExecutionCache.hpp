@@ -0,0 +1,88 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <list>
+#include <map>
+#include <ctime>
+#include <pthread.h>
+
+class AForm;
+class Bureaucrat;
+
+// LRU cache of recent executions keyed by (form type, target handle), so
+// a lookup builds no string. Only deterministic form types are cached: a
+// robotomy is always executed again. Safe for concurrent callers; the
+// form itself executes outside the lock, so two threads missing on the
+// same key at once may both execute it.
+class ExecutionCache {
+private:
+    typedef unsigned long long Key;
+
+    struct Entry {
+        Key key;
+        std::time_t expires;
+    };
+
+    typedef std::list<Entry> EntryList;
+    typedef std::map<Key, EntryList::iterator> EntryIndex;
+
+    // Holds the cache mutex for its scope, exceptions included
+    class Lock {
+    private:
+        pthread_mutex_t &mutex;
+
+        Lock(const Lock &src);
+        Lock &operator=(const Lock &src);
+
+    public:
+        Lock(const ExecutionCache &cache);
+        ~Lock();
+    };
+
+    EntryList entries;      // Most recently used first
+    EntryIndex index;
+    size_t capacity;
+    std::time_t ttl;
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;
+    mutable pthread_mutex_t mutex;
+
+    // False for forms that must not be cached
+    static bool makeKey(const AForm &form, Key &key);
+    bool isFresh(EntryIndex::const_iterator it, std::time_t now) const;
+    void insert(Key key, std::time_t now);
+    void copyFrom(const ExecutionCache &src);
+
+public:
+    // Constructors
+    ExecutionCache();
+    ExecutionCache(size_t _capacity, std::time_t _ttl);
+    ExecutionCache(const ExecutionCache &src);
+    ExecutionCache &operator=(const ExecutionCache &src);
+
+    // Destructor
+    ~ExecutionCache();
+
+    // Getters
+    size_t getSize() const;
+    size_t getCapacity() const;
+    std::time_t getTtl() const;
+    unsigned long getHits() const;
+    unsigned long getMisses() const;
+    unsigned long getEvictions() const;
+
+    // Member functions
+    bool execute(const AForm &form, const Bureaucrat &executor);
+    bool contains(const AForm &form) const;
+    void clear();
+
+    // Exceptions
+    class InvalidCapacityException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
+
+std::ostream &operator<<(std::ostream &out, const ExecutionCache &src);
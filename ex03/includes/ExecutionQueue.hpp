@@ -0,0 +1,105 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <pthread.h>
+
+class AForm;
+class Bureaucrat;
+
+// Handle on one submitted execution; a plain struct so Bureaucrat.hpp can
+// name it without including this header
+struct ExecutionTicket {
+    size_t id;
+};
+
+// Asynchronous execution on a small pool of worker threads, meant for
+// I/O-bound forms such as ShrubberyCreationForm: submit() returns a
+// ticket at once, the caller keeps signing while executions overlap on
+// the workers, and wait() collects the result. Executions may finish in
+// any order, but results are delivered (callbacks run, wait() returns)
+// strictly in submission order. Callbacks run on a worker thread.
+class ExecutionQueue {
+public:
+    typedef ExecutionTicket Ticket;
+
+    static const size_t DEFAULT_WORKERS = 4;
+
+    enum Status { PENDING, DONE, FAILED };
+    enum Error { NO_ERROR, FORM_NOT_SIGNED, GRADE_TOO_LOW, OTHER_ERROR };
+
+    // Completion record of one execution
+    struct Result {
+        Status status;
+        Error error;
+        std::string message;
+
+        Result();
+        // Throws the exception the execution failed with, if any
+        void rethrow() const;
+    };
+
+    typedef void (*Callback)(const AForm &form, const Result &result, void *data);
+
+private:
+    struct Job {
+        const AForm *form;
+        const Bureaucrat *executor;
+        Callback callback;
+        void *data;
+        bool finished;
+        Result result;
+    };
+
+    // Jobs are heap-allocated so results keep their address as the list grows
+    std::vector<Job *> jobs;
+    size_t next_job;            // Next job a worker picks up
+    size_t next_delivery;       // Next job whose result is delivered
+    bool delivering;            // A worker is running callbacks
+    bool stopping;
+    std::vector<pthread_t> workers;
+    mutable pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t delivered;
+
+    static Result runJob(const Job &job);
+    static void *workerLoop(void *arg);
+    void deliver();
+    const Job &getJob(Ticket ticket) const;
+
+    // Non-copyable: owns its worker threads
+    ExecutionQueue(const ExecutionQueue &src);
+    ExecutionQueue &operator=(const ExecutionQueue &src);
+
+public:
+    // Constructors
+    ExecutionQueue(size_t worker_count = DEFAULT_WORKERS);
+
+    // Destructor - waits for every submitted job
+    ~ExecutionQueue();
+
+    // Getters
+    size_t getWorkerCount() const;
+    size_t getPendingCount() const;
+    bool isDone(Ticket ticket) const;
+    const Result &getResult(Ticket ticket) const;
+
+    // Member functions
+    Ticket submit(const AForm &form, const Bureaucrat &executor,
+                  Callback callback = NULL, void *data = NULL);
+    const Result &wait(Ticket ticket);
+    void waitAll();
+
+    // Exceptions
+    class InvalidTicketException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class ThreadStartException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
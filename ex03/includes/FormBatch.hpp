@@ -0,0 +1,44 @@
+#pragma once
+#include <iostream>
+#include <cstddef>
+
+class AForm;
+
+// Forms created together by Intern::makeForms. All forms live in one
+// allocation, grouped by type, with the per-form pointers (in input
+// order) at its start; the whole batch is destroyed and freed at once.
+// The batch owns its forms, which are marked borrowed: FormHandle and
+// EpochReclaimer refuse them, and they must never be deleted directly.
+class FormBatch {
+private:
+    char *storage;
+    AForm **forms;
+    size_t count;
+
+    friend class Intern;
+
+    // Non-copyable: the forms live inside the batch's own buffer
+    FormBatch(const FormBatch &src);
+    FormBatch &operator=(const FormBatch &src);
+
+public:
+    typedef AForm *const *const_iterator;
+
+    // Constructors
+    FormBatch();
+
+    // Destructor
+    ~FormBatch();
+
+    // Span-like view, in the order the forms were requested
+    size_t size() const;
+    bool empty() const;
+    AForm &operator[](size_t index) const;
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    // Member functions
+    void clear();
+};
+
+std::ostream &operator<<(std::ostream &out, const FormBatch &src);
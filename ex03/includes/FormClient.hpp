@@ -0,0 +1,39 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include "FormProtocol.hpp"
+
+// Blocking client for FormService. Requests may be pipelined: send()
+// several frames, then receive() the responses in the same order.
+class FormClient {
+private:
+    int fd;
+    std::string in;
+
+    // Non-copyable: owns the connection
+    FormClient(const FormClient &src);
+    FormClient &operator=(const FormClient &src);
+
+public:
+    // Constructors
+    FormClient();
+
+    // Destructor
+    ~FormClient();
+
+    // Getters
+    int getFd() const;
+
+    // Member functions
+    void connect(const std::string &socket_path);
+    void send(const std::string &frames);
+    void receive(FormProtocol::Frame &frame);
+    void disconnect();
+
+    // Exceptions
+    class ConnectionException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include <iostream>
+#include "AForm.hpp"
+#include "TargetPool.hpp"
+
+// Compact stand-in for a form waiting in a queue: type id, grades,
+// target handle and signed state, 8 bytes, trivially copyable and never
+// allocated on its own. Signing is checked against the stored grades
+// directly; the concrete AForm is only built when the form is executed,
+// so forms rejected at signing never allocate anything.
+struct FormDescriptor {
+    unsigned char type_id;      // Intern::FormTypeId
+    unsigned char is_signed;
+    unsigned char grade_to_sign;
+    unsigned char grade_to_execute;
+    TargetPool::Handle target;
+
+    static FormDescriptor make(int typeId, const std::string &target);
+    static FormDescriptor make(int typeId, const std::string &target, int gradeToSign, int gradeToExecute);
+
+    // Getters
+    const char *getName() const;
+    const std::string &getTarget() const;
+    int getGradeToSign() const;
+    int getGradeToExecute() const;
+
+    // Same checks and exceptions as the AForm member functions
+    void beSigned(const Bureaucrat &bureaucrat);
+    void execute(Bureaucrat const &executor) const;
+
+    // Build the concrete form, signed if the descriptor is
+    AForm *materialize() const;
+};
+
+std::ostream &operator<<(std::ostream &out, const FormDescriptor &src);
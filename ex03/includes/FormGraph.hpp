@@ -0,0 +1,89 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <vector>
+#include <cstddef>
+
+class AForm;
+class Bureaucrat;
+
+// Forms with dependencies, run in topological waves: every form in a
+// wave only depends on forms of earlier waves, so the forms of a wave
+// run side by side on up to MAX_THREADS threads. When a form fails
+// (rejected, or its action failed like a robotomy) everything that
+// depends on it is cancelled. Output lines of one wave may interleave;
+// getCompletionOrder() tells in which order the forms finished.
+class FormGraph {
+public:
+    enum State { PENDING, SUCCEEDED, FAILED, CANCELLED };
+
+    static const size_t MAX_THREADS = 8;
+
+private:
+    struct Node {
+        const AForm *form;
+        std::vector<size_t> dependencies;
+        std::vector<size_t> dependents;
+        State state;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::vector<size_t> > waves;
+    std::vector<size_t> critical_path;
+    std::vector<size_t> completion_order;
+    double achieved_parallelism;
+
+    // One wave being executed; threads take forms by bumping next
+    struct WaveRun {
+        FormGraph *graph;
+        const std::vector<size_t> *forms;
+        const Bureaucrat *executor;
+        volatile size_t next;
+        volatile size_t *completed;
+        volatile unsigned long long *busy_ns;   // Summed execution time
+    };
+
+    void plan();
+    void cancelDependents(size_t node);
+    void runWave(const std::vector<size_t> &wave, const Bureaucrat &executor, volatile size_t &completed,
+                 volatile unsigned long long &busy_ns);
+    static void *runForms(void *arg);
+
+public:
+    // Constructors
+    FormGraph();
+    FormGraph(const FormGraph &src);
+    FormGraph &operator=(const FormGraph &src);
+
+    // Destructor
+    ~FormGraph();
+
+    // Building
+    size_t addForm(const AForm &form);
+    void addDependency(size_t node, size_t dependsOn);
+
+    // Running
+    void run(const Bureaucrat &executor);
+
+    // Reporting
+    size_t getFormCount() const;
+    State getState(size_t node) const;
+    size_t getWaveCount() const;
+    const std::vector<size_t> &getCriticalPath() const;
+    const std::vector<size_t> &getCompletionOrder() const;
+    double getMaxParallelism() const;
+    double getAchievedParallelism() const;
+
+    // Exceptions
+    class InvalidNodeException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class CycleException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
+
+std::ostream &operator<<(std::ostream &out, const FormGraph &src);
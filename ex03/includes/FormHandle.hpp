@@ -0,0 +1,54 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include "AForm.hpp"
+
+// Shared owner of a heap-allocated form. The reference count lives in
+// the form itself (no separate control block) and is updated
+// atomically, so handles can be passed between pipeline stages running
+// on different threads. The last handle deletes the form. Forms that
+// were not allocated on their own, like those of a FormBatch, are marked
+// borrowed and refused by the handle.
+class FormHandle {
+private:
+    AForm *form;
+
+    void retain() const;
+    void drop();
+
+public:
+    // Constructors
+    FormHandle();
+    explicit FormHandle(AForm *_form);
+    FormHandle(const FormHandle &src);
+    FormHandle &operator=(const FormHandle &src);
+
+    // Destructor
+    ~FormHandle();
+
+    // Getters
+    AForm *get() const;
+    AForm &operator*() const;
+    AForm *operator->() const;
+    bool isNull() const;
+    int getUseCount() const;
+
+    // Member functions
+    void reset(AForm *_form = NULL);
+    void swap(FormHandle &other);
+
+    // Borrowed forms belong to someone else and may never be deleted
+    static void markBorrowed(AForm &form);
+    static bool isBorrowed(const AForm &form);
+
+    // Exceptions
+    class NullHandleException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class BorrowedFormException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <vector>
+#include <cstddef>
+
+class AForm;
+class Bureaucrat;
+
+// Index over pending forms answering "what can this bureaucrat act on?".
+// Unsigned forms are bucketed by grade_to_sign and signed forms by
+// grade_to_execute, most lenient grade first, so the forms a given grade
+// can handle are always a prefix of their bucket array. Queries return
+// that prefix as a contiguous range in O(1). The index does not own the
+// forms and must be rebuilt after forms are signed.
+class FormIndex {
+public:
+    typedef std::vector<AForm *>::const_iterator const_iterator;
+
+    // Contiguous run of forms inside the index
+    struct Range {
+        const_iterator first;
+        const_iterator last;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+        size_t size() const;
+        bool empty() const;
+    };
+
+private:
+    static const int LOWEST_GRADE = 150;
+
+    std::vector<AForm *> unsigned_forms;
+    std::vector<AForm *> signed_forms;
+    // Number of forms a bureaucrat of grade g can handle, g = 1..150
+    std::vector<size_t> sign_prefix;
+    std::vector<size_t> execute_prefix;
+
+    static void bucket(const std::vector<AForm *> &forms, bool by_sign_grade,
+                       std::vector<AForm *> &sorted, std::vector<size_t> &prefix);
+    static Range prefixRange(const std::vector<AForm *> &forms,
+                             const std::vector<size_t> &prefix, int grade);
+
+public:
+    // Constructors
+    FormIndex();
+    FormIndex(const std::vector<AForm *> &forms);
+    FormIndex(const FormIndex &src);
+    FormIndex &operator=(const FormIndex &src);
+
+    // Destructor
+    ~FormIndex();
+
+    // Getters
+    size_t getUnsignedCount() const;
+    size_t getSignedCount() const;
+
+    // Member functions
+    void rebuild(const std::vector<AForm *> &forms);
+    Range signableBy(int grade) const;
+    Range signableBy(const Bureaucrat &bureaucrat) const;
+    Range executableBy(int grade) const;
+    Range executableBy(const Bureaucrat &bureaucrat) const;
+};
+
+std::ostream &operator<<(std::ostream &out, const FormIndex::Range &src);
@@ -0,0 +1,59 @@
+#pragma once
+#include <exception>
+#include <string>
+#include <cstddef>
+
+// Framed binary protocol spoken by FormService and its clients.
+// Every frame is a 4-byte header (opcode, status, 16-bit big-endian
+// payload length) followed by the payload. Ids and grades travel as
+// 32-bit big-endian words.
+class FormProtocol {
+public:
+    enum Opcode {
+        MAKE = 1,       // "form name\0target"        -> form id
+        SIGN = 2,       // form id, signer grade      -> empty
+        EXECUTE = 3,    // form id, executor grade    -> empty (grades 1-150)
+        RELEASE = 4     // form id                    -> empty
+    };
+
+    enum Status {
+        OK = 0,
+        ERROR = 1       // payload holds the exception message
+    };
+
+    static const size_t HEADER_SIZE = 4;
+    static const size_t MAX_PAYLOAD = 0xFFFF;
+
+    struct Frame {
+        unsigned char opcode;
+        unsigned char status;
+        std::string payload;
+    };
+
+    // Encoding
+    static void encode(std::string &out, unsigned char opcode, unsigned char status,
+                       const std::string &payload);
+    static void appendId(std::string &out, unsigned int id);
+    static unsigned int readId(const std::string &payload);
+    static void appendGrade(std::string &out, int grade);
+    // Grade following the form id; throws like Bureaucrat if out of range
+    static int readGrade(const std::string &payload);
+
+    // Returns false while the buffer does not hold a whole frame yet
+    static bool decode(const std::string &in, size_t &offset, Frame &frame);
+
+    // Request builders
+    static void makeRequest(std::string &out, const std::string &formName, const std::string &target);
+    static void signRequest(std::string &out, unsigned int id, int grade);
+    static void executeRequest(std::string &out, unsigned int id, int grade);
+    static void releaseRequest(std::string &out, unsigned int id);
+
+    // Exceptions
+    class BadFrameException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+private:
+    FormProtocol();
+};
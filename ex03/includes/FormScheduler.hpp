@@ -0,0 +1,66 @@
+#pragma once
+#include <iostream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <pthread.h>
+
+class AForm;
+class Bureaucrat;
+
+// Safe for concurrent callers: any thread may schedule, and several
+// threads may run the queue at once, each taking the next form in order.
+class FormScheduler {
+public:
+    // Microseconds on the monotonic clock
+    typedef long long Deadline;
+
+    // Deadline for forms that may wait behind everything else
+    static const Deadline NO_DEADLINE = 0;
+
+private:
+    struct Entry {
+        const AForm *form;
+        Deadline deadline;
+        int priority;
+        unsigned long sequence;
+    };
+
+    // Heap ordering: true when a must run after b
+    struct RunsAfter {
+        bool operator()(const Entry &a, const Entry &b) const;
+    };
+
+    std::priority_queue<Entry, std::vector<Entry>, RunsAfter> pending;
+    unsigned long next_sequence;
+    unsigned long executed;
+    unsigned long deadline_misses;
+    mutable pthread_mutex_t lock;
+
+    bool takeNext(Entry &entry);
+
+public:
+    // Constructors
+    FormScheduler();
+    FormScheduler(const FormScheduler &src);
+    FormScheduler &operator=(const FormScheduler &src);
+
+    // Destructor
+    ~FormScheduler();
+
+    // Getters
+    size_t getPendingCount() const;
+    unsigned long getExecutedCount() const;
+    unsigned long getDeadlineMisses() const;
+
+    // Current monotonic time, and a deadline relative to it
+    static Deadline now();
+    static Deadline fromNow(long long microseconds);
+
+    // Member functions
+    void schedule(const AForm &form, Deadline deadline, int priority = 0);
+    size_t run(const Bureaucrat &executor, size_t max_forms);
+    size_t runAll(const Bureaucrat &executor);
+};
+
+std::ostream &operator<<(std::ostream &out, const FormScheduler &src);
@@ -0,0 +1,90 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <vector>
+#include <map>
+#include <csignal>
+#include "FormProtocol.hpp"
+#include "Intern.hpp"
+
+// Long-lived bureaucracy daemon on a Unix domain socket.
+// A single poll() loop accepts clients, decodes every complete frame it
+// has read (so pipelined requests are handled as one batch) and queues
+// the responses back in request order. Forms belong to the connection
+// that made them and are freed when it closes. A client that half-closes
+// still gets every pending response before the connection is closed.
+// Targets become file names (ShrubberyCreationForm), so MAKE only
+// accepts plain names: no '/', no NUL and no leading '.'.
+class FormService {
+public:
+    // Bytes buffered per connection and direction before it is dropped
+    static const size_t MAX_BUFFERED = 1 << 20;
+
+private:
+    struct Connection {
+        int fd;
+        bool closing;           // Peer sent EOF; close once out is flushed
+        std::string in;
+        std::string out;
+        std::map<unsigned int, AForm *> forms;
+    };
+
+    std::string socket_path;
+    int listen_fd;
+    std::map<int, Connection> connections;
+    unsigned int next_id;
+    unsigned long handled;
+    volatile sig_atomic_t running;
+    Intern intern;
+
+    void acceptClients();
+    bool readClient(Connection &connection);
+    bool writeClient(Connection &connection);
+    void closeClient(int fd);
+    void handleFrame(const FormProtocol::Frame &frame, Connection &connection);
+    static void releaseForms(Connection &connection);
+    static AForm *findForm(Connection &connection, const std::string &payload);
+    static bool isValidTarget(const std::string &target);
+
+    // Non-copyable: owns the socket and the forms
+    FormService(const FormService &src);
+    FormService &operator=(const FormService &src);
+
+public:
+    // Constructors
+    FormService(const std::string &_socket_path);
+
+    // Destructor
+    ~FormService();
+
+    // Getters
+    unsigned long getHandledCount() const;
+    size_t getFormCount() const;
+
+    // Member functions
+    void open();
+    void run();
+    void stop();
+
+    // Exceptions
+    class SocketException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class UnknownFormException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class BadRequestException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class BadTargetException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
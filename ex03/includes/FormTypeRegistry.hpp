@@ -0,0 +1,89 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include "Intern.hpp"
+#include "FormDescriptor.hpp"
+#include "PermissionMatrix.hpp"
+
+class EpochReclaimer;
+
+// Form type definitions (Intern name and grades) loaded from a config
+// file and replaced at runtime. Each load builds a new immutable snapshot
+// and publishes it with one atomic pointer exchange. Readers see either
+// the old or the new snapshot, never a mix, without taking a lock. The
+// replaced snapshot is retired to an EpochReclaimer and freed once no
+// reader can still hold it. Every read takes the caller's reader slot
+// and holds an epoch guard while it touches the snapshot.
+//
+// Forms, descriptors and permission matrices built by the registry carry
+// the configured grades. Forms and descriptors keep them wherever they
+// go (ShardedExecutor records, BureaucracySnapshot files). Intern itself
+// and PermissionMatrix::standard() keep the compiled-in grades.
+//
+// Config lines: <class name> <grade to sign> <grade to execute> [<name>]
+// e.g. "RobotomyRequestForm 72 45 robotomy request". Types missing from
+// the file keep their compiled-in definition, '#' starts a comment.
+class FormTypeRegistry {
+public:
+    struct FormType {
+        std::string name;
+        int grade_to_sign;
+        int grade_to_execute;
+    };
+
+    // Immutable once published
+    struct Snapshot {
+        unsigned long version;
+        FormType types[Intern::FORM_TYPE_COUNT];
+
+        int findType(const std::string &name) const;
+    };
+
+private:
+    EpochReclaimer &reclaimer;
+    Snapshot *volatile current;
+    volatile unsigned long versions;
+
+    const Snapshot &currentSnapshot() const;
+    static int findType(const Snapshot &snapshot, const std::string &name);
+    static Snapshot *defaults();
+    static Snapshot *parse(std::istream &in);
+    static void deleteSnapshot(void *snapshot);
+    void publish(Snapshot *snapshot);
+
+    // Non-copyable: readers hold pointers into the published snapshot
+    FormTypeRegistry(const FormTypeRegistry &src);
+    FormTypeRegistry &operator=(const FormTypeRegistry &src);
+
+public:
+    // Constructors - starts with the compiled-in form types
+    FormTypeRegistry(EpochReclaimer &_reclaimer);
+
+    // Destructor - no reader may be active
+    ~FormTypeRegistry();
+
+    // Readers - slot is the caller's EpochReclaimer reader slot
+    Snapshot getSnapshot(int slot) const;
+    unsigned long getVersion(int slot) const;
+    AForm *makeForm(int slot, const std::string &name, const std::string &target) const;
+    FormDescriptor makeFormDescriptor(int slot, const std::string &name, const std::string &target) const;
+    PermissionMatrix makePermissionMatrix(int slot) const;
+
+    // Writers - on error the current snapshot stays in place
+    void load(std::istream &in);
+    void load(const std::string &path);
+
+    // Exceptions
+    class InvalidConfigException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class ConfigFileException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
+
+std::ostream &operator<<(std::ostream &out, const FormTypeRegistry::Snapshot &src);
@@ -3,6 +3,10 @@
 #include "ShrubberyCreationForm.hpp"
 #include "RobotomyRequestForm.hpp"
 #include "PresidentialPardonForm.hpp"
+#include "FormHandle.hpp"
+#include "FormDescriptor.hpp"
+#include "FormBatch.hpp"
+#include <vector>
 #include <string>
 
 class Intern {
@@ -12,13 +16,41 @@ private:
     AForm* createRobotomyForm(const std::string &target);
     AForm* createPresidentialForm(const std::string &target);
     
+    // Creation with grades other than the compiled-in ones
+    static AForm* createShrubberyFormWithGrades(const std::string &target, int gradeToSign, int gradeToExecute);
+    static AForm* createRobotomyFormWithGrades(const std::string &target, int gradeToSign, int gradeToExecute);
+    static AForm* createPresidentialFormWithGrades(const std::string &target, int gradeToSign, int gradeToExecute);
+    
+    // Construction in caller-provided memory, for batches
+    static AForm* placeShrubberyForm(void *where, const std::string &target);
+    static AForm* placeRobotomyForm(void *where, const std::string &target);
+    static AForm* placePresidentialForm(void *where, const std::string &target);
+    
     // Structure to map form names to creation functions
     struct FormType {
-        std::string name;
+        const char *name;
+        const char *class_name;
+        int grade_to_sign;
+        int grade_to_execute;
+        bool deterministic;         // Same outcome every time it executes
         AForm* (Intern::*creator)(const std::string &target);
+        AForm* (*creator_with_grades)(const std::string &target, int gradeToSign, int gradeToExecute);
+        size_t size;
+        size_t alignment;
+        AForm* (*placer)(void *where, const std::string &target);
     };
 
+    static const FormType form_types[];
+
 public:
+    // Stable ids of the known form types, usable in compact records
+    enum FormTypeId {
+        SHRUBBERY_CREATION,
+        ROBOTOMY_REQUEST,
+        PRESIDENTIAL_PARDON,
+        FORM_TYPE_COUNT
+    };
+
     // Constructors
     Intern();
     Intern(const Intern &src);
@@ -29,10 +61,31 @@ public:
     
     // Main method - Factory pattern implementation
     AForm* makeForm(const std::string &formName, const std::string &target);
+    AForm* makeForm(int typeId, const std::string &target);
+    // Needs no intern instance, for callers that only hold a type id
+    static AForm* makeForm(int typeId, const std::string &target, int gradeToSign, int gradeToExecute);
+    FormHandle makeFormHandle(const std::string &formName, const std::string &target);
+    FormDescriptor makeFormDescriptor(const std::string &formName, const std::string &target);
+    void makeForms(const std::vector<std::string> &formNames, const std::vector<std::string> &targets,
+                   FormBatch &batch);
+    
+    // Form type lookup - returns -1 for unknown names or forms
+    static int getFormTypeId(const std::string &formName);
+    static int getFormTypeId(const AForm &form);
+    static const char *getFormTypeName(int typeId);
+    static const char *getFormClassName(int typeId);
+    static int getGradeToSign(int typeId);
+    static int getGradeToExecute(int typeId);
+    static bool isDeterministic(int typeId);
     
     // Exception for unknown form types
     class FormNotFoundException : public std::exception {
     public:
         virtual const char *what() const throw();
     };
+    
+    class BatchSizeMismatchException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
 };
@@ -0,0 +1,92 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <vector>
+#include <utility>
+#include "Intern.hpp"
+#include "TargetPool.hpp"
+
+class AForm;
+class Bureaucrat;
+
+// Counters for the outcomes seen by one worker. Each worker owns its own
+// shard, so recording never contends; shards are merged on demand.
+// Every counter is a fixed array indexed by form type, stage or grade
+// band, and target counts are indexed by TargetPool handle, so recording
+// an outcome only allocates the first time a shard sees a new target.
+class OutcomeShard {
+public:
+    enum Stage { SIGN, EXECUTE, STAGE_COUNT };
+
+    static const int BAND_SIZE = 10;                // Grades 1-10, 11-20, ...
+    static const int BAND_COUNT = 150 / BAND_SIZE;
+
+private:
+    unsigned long attempts[Intern::FORM_TYPE_COUNT][STAGE_COUNT];
+    unsigned long band_attempts[STAGE_COUNT][BAND_COUNT];
+    unsigned long band_rejections[STAGE_COUNT][BAND_COUNT];
+    unsigned long robotomy_attempts;
+    unsigned long robotomy_successes;
+    std::vector<unsigned long> targets;             // Indexed by TargetPool::Handle
+    char padding[64];                               // Keeps neighbouring shards apart
+
+public:
+    // Constructors
+    OutcomeShard();
+    OutcomeShard(const OutcomeShard &src);
+    OutcomeShard &operator=(const OutcomeShard &src);
+
+    // Destructor
+    ~OutcomeShard();
+
+    // Recording
+    void record(int typeId, Stage stage, int grade, bool accepted, TargetPool::Handle target);
+    void recordRobotomy(bool succeeded);
+    bool sign(AForm &form, const Bureaucrat &signer);
+    bool execute(const AForm &form, const Bureaucrat &executor);
+    void merge(const OutcomeShard &other);
+    void reset();
+
+    // Queries
+    unsigned long getAttempts(int typeId, Stage stage) const;
+    unsigned long getBandAttempts(Stage stage, int band) const;
+    double getRejectionRate(Stage stage, int band) const;
+    double getRobotomySuccessRatio() const;
+    void getTopTargets(size_t count, std::vector<std::pair<std::string, unsigned long> > &out) const;
+
+    // Exceptions
+    class InvalidBandException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
+
+class OutcomeAggregator {
+private:
+    std::vector<OutcomeShard> shards;
+
+public:
+    // Constructors
+    OutcomeAggregator();
+    OutcomeAggregator(size_t shard_count);
+    OutcomeAggregator(const OutcomeAggregator &src);
+    OutcomeAggregator &operator=(const OutcomeAggregator &src);
+
+    // Destructor
+    ~OutcomeAggregator();
+
+    // Member functions
+    size_t getShardCount() const;
+    OutcomeShard &getShard(size_t index);
+    OutcomeShard merge() const;
+    void reset();
+
+    // Exceptions
+    class InvalidShardException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
+
+std::ostream &operator<<(std::ostream &out, const OutcomeShard &src);
@@ -0,0 +1,63 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+class Bureaucrat;
+
+// Roster stored column-wise: names in one array, grades packed one byte
+// each in another, so bulk grade updates stream over a dense byte array.
+// A per-grade histogram is kept up to date by every update.
+class PackedRoster {
+public:
+    static const int HIGHEST_GRADE = 1;
+    static const int LOWEST_GRADE = 150;
+
+    // A delta that would have left the 1-150 range, applied saturated
+    struct GradeError {
+        size_t index;
+        int grade;      // Grade before the update
+        int delta;      // Requested delta, positive = promotion
+    };
+
+private:
+    std::vector<std::string> names;
+    std::vector<unsigned char> grades;
+    std::vector<size_t> histogram;
+
+public:
+    // Constructors
+    PackedRoster();
+    PackedRoster(const PackedRoster &src);
+    PackedRoster &operator=(const PackedRoster &src);
+
+    // Destructor
+    ~PackedRoster();
+
+    // Getters
+    size_t getSize() const;
+    const std::string &getName(size_t index) const;
+    int getGrade(size_t index) const;
+    size_t countAtGrade(int grade) const;
+    size_t countAtOrAbove(int grade) const;
+
+    // Member functions
+    size_t add(const std::string &name, int grade);
+    size_t add(const Bureaucrat &bureaucrat);
+    size_t applyDeltas(const std::vector<int> &deltas, std::vector<GradeError> &errors);
+
+    // Exceptions
+    class IndexOutOfRangeException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class SizeMismatchException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
+
+std::ostream &operator<<(std::ostream &out, const PackedRoster &src);
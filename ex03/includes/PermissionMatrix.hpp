@@ -0,0 +1,54 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <bitset>
+#include <cstddef>
+
+// Precomputed answers to "may grade g sign / execute form type t?".
+// Grades are bounded to 1..150, so every answer is one bit, filled in
+// when the form type is registered. A query is a single bit test.
+//
+// It answers per type, before any form exists: e.g. which of a batch of
+// requests a grade may even submit, under the compiled-in grades
+// (standard()) or a FormTypeRegistry configuration. It does not replace
+// the checks in AForm::beSigned/checkExecution: a form carries its own
+// grades, which may differ from its type's, and comparing against them
+// is already one comparison.
+class PermissionMatrix {
+public:
+    static const int MAX_TYPES = 16;
+    static const int GRADE_COUNT = 151;     // Index 0 is never allowed
+
+private:
+    std::bitset<GRADE_COUNT> can_sign[MAX_TYPES];
+    std::bitset<GRADE_COUNT> can_execute[MAX_TYPES];
+    int type_count;
+
+public:
+    // Constructors
+    PermissionMatrix();
+    PermissionMatrix(const PermissionMatrix &src);
+    PermissionMatrix &operator=(const PermissionMatrix &src);
+
+    // Destructor
+    ~PermissionMatrix();
+
+    // Matrix for the form types Intern knows about
+    static PermissionMatrix standard();
+
+    // Getters
+    int getTypeCount() const;
+
+    // Member functions
+    void registerType(int typeId, int gradeToSign, int gradeToExecute);
+    bool canSign(int grade, int typeId) const;
+    bool canExecute(int grade, int typeId) const;
+    void canSign(const int *grades, const int *typeIds, size_t count, bool *out) const;
+    void canExecute(const int *grades, const int *typeIds, size_t count, bool *out) const;
+
+    // Exceptions
+    class InvalidTypeException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
@@ -1,14 +1,20 @@
 #pragma once
 #include "AForm.hpp"
+#include "TargetPool.hpp"
 
 class PresidentialPardonForm : public AForm {
 private:
-    std::string target;
+    TargetPool::Handle target;     // Shared string in the TargetPool
 
 public:
+    // Fixed grade requirements
+    static const int GRADE_TO_SIGN = 25;
+    static const int GRADE_TO_EXECUTE = 5;
+    
     // Constructors
     PresidentialPardonForm();
     PresidentialPardonForm(const std::string &target);
+    PresidentialPardonForm(const std::string &target, int gradeToSign, int gradeToExecute);
     PresidentialPardonForm(const PresidentialPardonForm &src);
     PresidentialPardonForm &operator=(const PresidentialPardonForm &src);
     
@@ -16,8 +22,21 @@ public:
     virtual ~PresidentialPardonForm();
     
     // Getter
-    std::string getTarget() const;
+    virtual const std::string &getTarget() const;
+    virtual TargetPool::Handle getTargetHandle() const;
+    
+    // Cheap swap for containers and algorithms
+    void swap(PresidentialPardonForm &other);
     
     // Execute implementation
     virtual void execute(Bureaucrat const &executor) const;
 };
+
+void swap(PresidentialPardonForm &a, PresidentialPardonForm &b);
+
+namespace std {
+    template <>
+    inline void swap<PresidentialPardonForm>(PresidentialPardonForm &a, PresidentialPardonForm &b) {
+        a.swap(b);
+    }
+}
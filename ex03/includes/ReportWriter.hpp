@@ -0,0 +1,46 @@
+#pragma once
+#include <iostream>
+#include <string>
+#include <vector>
+
+class AForm;
+class Bureaucrat;
+
+// Buffered writer for large status reports. Records are formatted by
+// hand into one preallocated buffer (no iostream formatting, no
+// temporary strings) and flushed in big chunks. The text is
+// byte-identical to the operator<< overloads.
+class ReportWriter {
+private:
+    std::ostream &out;
+    std::vector<char> buffer;
+    size_t used;
+
+    void reserve(size_t length);
+    void append(const char *text, size_t length);
+    void append(const std::string &text);
+    void appendInt(int value);
+
+    // Non-copyable: holds a reference to its stream
+    ReportWriter(const ReportWriter &src);
+    ReportWriter &operator=(const ReportWriter &src);
+
+public:
+    static const size_t DEFAULT_CAPACITY = 1 << 20;
+
+    // Constructors
+    ReportWriter(std::ostream &_out, size_t capacity = DEFAULT_CAPACITY);
+
+    // Destructor - flushes what is left
+    ~ReportWriter();
+
+    // Getters
+    size_t getBufferedSize() const;
+
+    // Member functions
+    void write(const AForm &form);
+    void write(const Bureaucrat &bureaucrat);
+    void write(const std::string &text);
+    void write(char c);
+    void flush();
+};
@@ -1,16 +1,31 @@
 #pragma once
 #include "AForm.hpp"
+#include "TargetPool.hpp"
 #include <cstdlib>
 #include <ctime>
 
 class RobotomyRequestForm : public AForm {
 private:
-    std::string target;
+    TargetPool::Handle target;     // Shared string in the TargetPool
+
+    // Outcome draws: the process seed is set once, then every thread
+    // draws from its own rand_r state, so forms may run on any thread
+    static unsigned int process_seed;
+    static void seedProcess();
+    static int nextRandom();
 
 public:
+    // Fixed grade requirements
+    static const int GRADE_TO_SIGN = 72;
+    static const int GRADE_TO_EXECUTE = 45;
+    
+    // Probability (in percent) that a robotomy succeeds
+    static const int SUCCESS_PERCENT = 50;
+
     // Constructors
     RobotomyRequestForm();
     RobotomyRequestForm(const std::string &target);
+    RobotomyRequestForm(const std::string &target, int gradeToSign, int gradeToExecute);
     RobotomyRequestForm(const RobotomyRequestForm &src);
     RobotomyRequestForm &operator=(const RobotomyRequestForm &src);
     
@@ -18,8 +33,22 @@ public:
     virtual ~RobotomyRequestForm();
     
     // Getter
-    std::string getTarget() const;
+    virtual const std::string &getTarget() const;
+    virtual TargetPool::Handle getTargetHandle() const;
+    
+    // Cheap swap for containers and algorithms
+    void swap(RobotomyRequestForm &other);
     
     // Execute implementation
     virtual void execute(Bureaucrat const &executor) const;
+    virtual bool perform(Bureaucrat const &executor) const;
 };
+
+void swap(RobotomyRequestForm &a, RobotomyRequestForm &b);
+
+namespace std {
+    template <>
+    inline void swap<RobotomyRequestForm>(RobotomyRequestForm &a, RobotomyRequestForm &b) {
+        a.swap(b);
+    }
+}
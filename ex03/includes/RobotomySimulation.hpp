@@ -0,0 +1,93 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <map>
+#include <vector>
+#include <cstddef>
+
+// Monte-Carlo robotomies, split across threads. Outcome i of a run only
+// depends on the seed and i (counter-based draws), so the result is the
+// same whatever the number of threads.
+class RobotomySimulation {
+public:
+    // Aggregated outcome of the robotomies drawn for one target group
+    struct Result {
+        unsigned long successes;
+        unsigned long failures;
+
+        Result();
+        unsigned long total() const;
+        double successRatio() const;
+        // 95% Wilson score interval of the success ratio
+        double lowerBound() const;
+        double upperBound() const;
+    };
+
+    static const size_t MAX_THREADS = 8;
+
+private:
+    // One thread's share of a run: words [first_word, first_word + words)
+    struct Slice {
+        const RobotomySimulation *simulation;
+        unsigned long long first_word;
+        unsigned long count;
+        unsigned long successes;
+    };
+
+    std::map<std::string, Result> groups;
+    std::vector<Result> slices;
+    int success_percent;
+    size_t thread_count;
+    unsigned long long seed;
+    unsigned long long next_word;   // Words used by earlier runs
+
+    // splitmix64 of the word index - no state chained between draws
+    unsigned long long randomWord(unsigned long long index) const;
+    unsigned long drawBatch(unsigned long long first_word, unsigned long count) const;
+    static void *runSlice(void *arg);
+
+public:
+    // Number of outcomes drawn from a single 64-bit random word
+    static const int BATCH_WIDTH = 4;
+
+    // Constructors
+    RobotomySimulation();
+    RobotomySimulation(int _success_percent, unsigned long long _seed,
+                       size_t _thread_count = MAX_THREADS);
+    RobotomySimulation(const RobotomySimulation &src);
+    RobotomySimulation &operator=(const RobotomySimulation &src);
+
+    // Destructor
+    ~RobotomySimulation();
+
+    // Getters
+    int getSuccessPercent() const;
+    size_t getThreadCount() const;
+    // Per-thread share of the last run
+    const std::vector<Result> &getSlices() const;
+    const Result &getResult(const std::string &group) const;
+    Result getTotal() const;
+
+    // Member functions
+    const Result &run(const std::string &group, unsigned long count);
+    void reset();
+
+    // Exceptions
+    class InvalidSuccessPercentException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class InvalidThreadCountException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class GroupNotFoundException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
+
+std::ostream &operator<<(std::ostream &out, const RobotomySimulation::Result &src);
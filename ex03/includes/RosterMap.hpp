@@ -0,0 +1,97 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "TargetPool.hpp"
+
+class Bureaucrat;
+
+// Concurrent open-addressing map from bureaucrat name to bureaucrat.
+// Lookups are lock-free and take the name as (pointer, length), so no
+// string is built per lookup. Updates lock one of LOCK_STRIPES stripes
+// picked by the name's hash, so writers of the same name are serialized
+// and writers of different names only meet on the CAS that claims a
+// slot. Removed slots are tombstoned and reused by later inserts. Every
+// access to a slot field shared with other threads is an __atomic or
+// __sync operation (acquire loads, release publication), so the map is
+// race-free as ThreadSanitizer sees it, not only in practice.
+//
+// Each entry keeps its own key, interned in TargetPool when it is
+// inserted, so lookups never read a bureaucrat and an entry stays under
+// the name it was inserted with even if the bureaucrat is later renamed
+// by assignment. The map does not own the bureaucrats: one must outlive
+// its entry and every caller still using a pointer that find() returned.
+// When bureaucrats are destroyed while readers run, remove them and free
+// them through an EpochReclaimer instead of deleting them directly.
+class RosterMap {
+public:
+    static const int LOCK_STRIPES = 64;
+
+private:
+    struct Slot {
+        volatile unsigned long hash;        // 0 = never used
+        volatile TargetPool::Handle key;    // Set before value is published
+        Bureaucrat *volatile value;         // NULL while being filled
+    };
+
+    // Holds the update stripe of one hash for the guard's lifetime
+    class StripeLock {
+    private:
+        volatile int &lock;
+
+        StripeLock(const StripeLock &src);
+        StripeLock &operator=(const StripeLock &src);
+
+    public:
+        StripeLock(RosterMap &map, unsigned long hash);
+        ~StripeLock();
+    };
+
+    std::vector<Slot> slots;
+    size_t mask;
+    volatile size_t used_slots;
+    volatile size_t size;
+    volatile int locks[LOCK_STRIPES];
+
+    static unsigned long hashName(const char *name, size_t length);
+    static bool matches(const Slot &slot, const char *name, size_t length);
+    static unsigned long loadHash(const Slot &slot);
+    static Bureaucrat *loadValue(const Slot &slot);
+    static bool isLive(const Bureaucrat *value);
+    static Bureaucrat *tombstone();
+    Slot *findSlot(unsigned long hash, const char *name, size_t length);
+    void claimSlot(unsigned long hash, TargetPool::Handle key, Bureaucrat &bureaucrat);
+
+    // Non-copyable: concurrent users hold on to it
+    RosterMap(const RosterMap &src);
+    RosterMap &operator=(const RosterMap &src);
+
+public:
+    // Constructors
+    RosterMap(size_t capacity);
+
+    // Destructor
+    ~RosterMap();
+
+    // Getters
+    size_t getSize() const;
+    size_t getCapacity() const;
+
+    // Lookups
+    Bureaucrat *find(const char *name, size_t length) const;
+    Bureaucrat *find(const std::string &name) const;
+
+    // Updates
+    bool insert(Bureaucrat &bureaucrat);
+    Bureaucrat *put(Bureaucrat &bureaucrat);
+    bool remove(const char *name, size_t length);
+    bool remove(const std::string &name);
+
+    // Exceptions
+    class MapFullException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+class AForm;
+
+// Compact, self-contained description of a form to execute in a worker.
+// Targets longer than TARGET_SIZE are rejected, never truncated.
+struct FormRecord {
+    static const int TARGET_SIZE = 58;
+
+    unsigned char type_id;
+    unsigned char grade_to_sign;        // The form's own grades, which may
+    unsigned char grade_to_execute;     // come from FormTypeRegistry
+    unsigned char signer_grade;
+    unsigned char executor_grade;
+    unsigned char target_length;
+    char target[TARGET_SIZE];
+};
+
+class ShardedExecutor {
+public:
+    // Slots per worker ring - must be a power of two
+    static const size_t RING_SIZE = 1024;
+
+private:
+    // Single-producer/single-consumer ring living in shared memory.
+    // head and tail sit on separate cache lines.
+    struct Ring {
+        volatile size_t head;
+        char head_padding[64 - sizeof(size_t)];
+        volatile size_t tail;
+        char tail_padding[64 - sizeof(size_t)];
+        FormRecord slots[RING_SIZE];
+    };
+
+    Ring *rings;
+    std::vector<pid_t> workers;
+    int worker_count;
+    size_t next_shard;
+    unsigned long submitted;
+
+    bool push(size_t shard, const FormRecord &record);
+    bool isWorkerAlive(size_t shard);
+    static void workerLoop(Ring &ring);
+
+    // Non-copyable: owns the shared mapping and the worker processes
+    ShardedExecutor(const ShardedExecutor &src);
+    ShardedExecutor &operator=(const ShardedExecutor &src);
+
+public:
+    // Constructors
+    ShardedExecutor(int _worker_count);
+
+    // Destructor
+    ~ShardedExecutor();
+
+    // Getters
+    int getWorkerCount() const;
+    unsigned long getSubmittedCount() const;
+    bool isRunning() const;
+    pid_t getWorkerPid(int shard) const;
+
+    // Member functions
+    static FormRecord makeRecord(const AForm &form, int signer_grade, int executor_grade);
+    void start();
+    void submit(const FormRecord &record);
+    void stop();
+
+    // Exceptions
+    class InvalidWorkerCountException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class TargetTooLongException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class WorkerDiedException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class SystemErrorException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
@@ -1,15 +1,21 @@
 #pragma once
 #include "AForm.hpp"
+#include "TargetPool.hpp"
 #include <fstream>
 
 class ShrubberyCreationForm : public AForm {
 private:
-    std::string target;
+    TargetPool::Handle target;     // Shared string in the TargetPool
 
 public:
+    // Fixed grade requirements
+    static const int GRADE_TO_SIGN = 145;
+    static const int GRADE_TO_EXECUTE = 137;
+    
     // Constructors
     ShrubberyCreationForm();
     ShrubberyCreationForm(const std::string &target);
+    ShrubberyCreationForm(const std::string &target, int gradeToSign, int gradeToExecute);
     ShrubberyCreationForm(const ShrubberyCreationForm &src);
     ShrubberyCreationForm &operator=(const ShrubberyCreationForm &src);
     
@@ -17,8 +23,21 @@ public:
     virtual ~ShrubberyCreationForm();
     
     // Getter
-    std::string getTarget() const;
+    virtual const std::string &getTarget() const;
+    virtual TargetPool::Handle getTargetHandle() const;
+    
+    // Cheap swap for containers and algorithms
+    void swap(ShrubberyCreationForm &other);
     
     // Execute implementation
     virtual void execute(Bureaucrat const &executor) const;
 };
+
+void swap(ShrubberyCreationForm &a, ShrubberyCreationForm &b);
+
+namespace std {
+    template <>
+    inline void swap<ShrubberyCreationForm>(ShrubberyCreationForm &a, ShrubberyCreationForm &b) {
+        a.swap(b);
+    }
+}
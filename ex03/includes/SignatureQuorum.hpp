@@ -0,0 +1,83 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+class AForm;
+class Bureaucrat;
+
+// k-of-n signing for high-value forms. Each of the n seats belongs to
+// one named signer, fixed when the quorum is built, and names must be
+// distinct, so one bureaucrat counts at most once. A signer is matched
+// by its name when it signs: a Bureaucrat assigned from another one
+// signs as that one, just like a second Bureaucrat of the same name.
+// Each seat is one bit of an atomic bitmap; a new signature sets its bit
+// and bumps an atomic counter, without any mutex. While the quorum exists
+// it is the only way to sign the form: AForm::beSigned refuses, and the
+// form reads as signed as soon as the counter reaches the quorum. When
+// the quorum is destroyed the form keeps the state it reached.
+class SignatureQuorum {
+private:
+    static const size_t BITS_PER_WORD = sizeof(unsigned long) * 8;
+
+    AForm &form;
+    size_t signer_count;
+    int required;
+    int min_grade;
+    std::vector<std::string> holders;
+    std::vector<unsigned long> seats;
+    volatile int signatures;
+
+    // Non-copyable: concurrent signers share one quorum
+    SignatureQuorum(const SignatureQuorum &src);
+    SignatureQuorum &operator=(const SignatureQuorum &src);
+
+public:
+    // Constructors
+    SignatureQuorum(AForm &_form, const std::vector<std::string> &_signers, int _required, int _min_grade);
+
+    // Destructor
+    ~SignatureQuorum();
+
+    // Getters
+    size_t getSignerCount() const;
+    int getRequired() const;
+    int getMinGrade() const;
+    int getSignatureCount() const;
+    bool isReached() const;
+    bool hasSigned(size_t seat) const;
+    const std::string &getHolder(size_t seat) const;
+
+    // Member functions
+    bool sign(size_t seat, const Bureaucrat &signer);
+
+    // Exceptions
+    class InvalidQuorumException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class InvalidSeatException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class DuplicateSignerException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class NotSeatHolderException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class FormAlreadyBoundException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
+
+std::ostream &operator<<(std::ostream &out, const SignatureQuorum &src);
@@ -0,0 +1,75 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <cstddef>
+
+// Process-wide, append-only pool of form targets. Each distinct target
+// string is stored once and named by a small integer handle that stays
+// valid for the lifetime of the program, so forms only carry the handle.
+//
+// Strings live in fixed-size chunks that never move. Lookups (get, and
+// intern of a known target) are lock-free: they read the chunk table and
+// probe an open-addressing hash index of handles. Adding a new target
+// takes a spinlock, appends the string, then publishes the new count and
+// the index slot; the lock is released even when an allocation throws.
+// Readers pair an acquire load of the count with that publication.
+// Outgrown indexes are kept, never freed, so a reader still probing one
+// stays safe; a miss there falls back to the locked path.
+class TargetPool {
+public:
+    typedef unsigned int Handle;
+
+    static const size_t CHUNK_SIZE = 1024;
+    static const size_t MAX_CHUNKS = 4096;
+
+private:
+    struct Index {
+        size_t mask;
+        volatile Handle *slots;     // handle + 1, 0 = empty
+        Index *previous;
+    };
+
+    // Holds the append lock for its scope, exceptions included
+    class Lock {
+    private:
+        Lock(const Lock &src);
+        Lock &operator=(const Lock &src);
+
+    public:
+        Lock();
+        ~Lock();
+    };
+
+    static std::string *volatile chunks[MAX_CHUNKS];
+    static volatile size_t count;
+    static Index *volatile index;
+    static volatile int lock;
+
+    static unsigned long hashTarget(const std::string &target);
+    static bool find(const Index *index, const std::string &target, unsigned long hash, Handle &handle);
+    static void insert(Index *index, unsigned long hash, Handle handle);
+    static Index *grow(Index *current);
+
+    // Static-only: there is one pool per process
+    TargetPool();
+    TargetPool(const TargetPool &src);
+    TargetPool &operator=(const TargetPool &src);
+    ~TargetPool();
+
+public:
+    static Handle intern(const std::string &target);
+    static const std::string &get(Handle handle);
+    static size_t getSize();
+
+    // Exceptions
+    class InvalidHandleException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+
+    class PoolFullException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
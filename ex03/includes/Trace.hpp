@@ -0,0 +1,43 @@
+#pragma once
+
+// Static tracepoints on the sign/execute hot paths, for perf and bpftrace.
+// Built with FORM_TRACE_USDT (the Makefile sets it when <sys/sdt.h> is
+// installed) each probe is a USDT probe of provider "bureaucracy": a
+// single nop in the code plus an ELF note. Each probe has a semaphore
+// (defined in Trace.cpp) that the tracer bumps while it is attached, and
+// the arguments are only evaluated then: with nobody attached a probe
+// costs one load and a not-taken branch. Without FORM_TRACE_USDT the
+// probes expand to nothing. Arguments must not have side effects.
+//
+//   sign(form, grade_to_sign, bureaucrat_grade, signed)
+//   check_execution(form, grade_to_execute, executor_grade, outcome)
+//       outcome: 0 allowed, 1 not signed, 2 grade too low
+//   execute_start(form, target, executor_grade)
+//   execute_done(form, target, succeeded)
+//   make_form(form, type_id, target)
+//
+// e.g. bpftrace -e 'usdt:./Bureaucrat:bureaucracy:sign { @[str(arg0), arg3] = count(); }'
+
+#ifdef FORM_TRACE_USDT
+# define _SDT_HAS_SEMAPHORES 1
+# include <sys/sdt.h>
+
+extern volatile unsigned short bureaucracy_sign_semaphore;
+extern volatile unsigned short bureaucracy_check_execution_semaphore;
+extern volatile unsigned short bureaucracy_execute_start_semaphore;
+extern volatile unsigned short bureaucracy_execute_done_semaphore;
+extern volatile unsigned short bureaucracy_make_form_semaphore;
+
+# define FORM_TRACE_ENABLED(probe) __builtin_expect(bureaucracy_##probe##_semaphore != 0, 0)
+# define FORM_TRACE3(probe, a, b, c) do { \
+        if (FORM_TRACE_ENABLED(probe)) \
+            DTRACE_PROBE3(bureaucracy, probe, a, b, c); \
+    } while (0)
+# define FORM_TRACE4(probe, a, b, c, d) do { \
+        if (FORM_TRACE_ENABLED(probe)) \
+            DTRACE_PROBE4(bureaucracy, probe, a, b, c, d); \
+    } while (0)
+#else
+# define FORM_TRACE3(probe, a, b, c) do { } while (0)
+# define FORM_TRACE4(probe, a, b, c, d) do { } while (0)
+#endif
@@ -0,0 +1,71 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <vector>
+
+// One synthetic request - names point into the generator's tables, so
+// producing a request never allocates
+struct WorkloadRequest {
+    const std::string *form_name;
+    const std::string *target;
+    int signer_grade;
+    int executor_grade;
+};
+
+class WorkloadGenerator {
+public:
+    struct Config {
+        int shrubbery_weight;
+        int robotomy_weight;
+        int pardon_weight;
+        int invalid_percent;        // Share of names Intern will reject
+        int signer_min_grade;
+        int signer_max_grade;
+        int executor_min_grade;
+        int executor_max_grade;
+        size_t target_count;        // Number of distinct targets
+        unsigned long long seed;
+
+        Config();
+    };
+
+private:
+    Config config;
+    std::vector<std::string> form_names;
+    std::vector<std::string> invalid_names;
+    std::vector<std::string> targets;
+    unsigned int shrubbery_limit;   // Form type thresholds on a 16-bit draw
+    unsigned int robotomy_limit;
+    unsigned int invalid_limit;
+    unsigned long long state;
+
+    unsigned long long nextRandom();
+    void setup();
+
+public:
+    // Constructors
+    WorkloadGenerator();
+    WorkloadGenerator(const Config &_config);
+    WorkloadGenerator(const WorkloadGenerator &src);
+    WorkloadGenerator &operator=(const WorkloadGenerator &src);
+
+    // Destructor
+    ~WorkloadGenerator();
+
+    // Getters
+    const Config &getConfig() const;
+
+    // Member functions
+    void next(WorkloadRequest &request);
+    void generate(WorkloadRequest *requests, size_t count);
+    void write(std::ostream &out, size_t count);
+
+    // Exceptions
+    class InvalidConfigException : public std::exception {
+    public:
+        virtual const char *what() const throw();
+    };
+};
+
+std::ostream &operator<<(std::ostream &out, const WorkloadRequest &src);
@@ -1,31 +1,38 @@
 #include "AForm.hpp"
 #include "Bureaucrat.hpp"
+#include "SignatureQuorum.hpp"
+#include "Trace.hpp"
 
 // Default constructor
-AForm::AForm() : name("default"), is_signed(false), grade_to_sign(150), grade_to_execute(150) {
+AForm::AForm()
+    : name("default"), is_signed(false), grade_to_sign(150), grade_to_execute(150), ref_count(0), quorum(NULL) {
 }
 
 // Parameterized constructor
 AForm::AForm(const std::string _name, int _grade_to_sign, int _grade_to_execute)
-    : name(_name), is_signed(false), grade_to_sign(_grade_to_sign), grade_to_execute(_grade_to_execute) {
+    : name(_name), is_signed(false), grade_to_sign(_grade_to_sign), grade_to_execute(_grade_to_execute),
+      ref_count(0), quorum(NULL) {
     if (_grade_to_sign < 1 || _grade_to_execute < 1)
         throw AForm::GradeTooHighException();
     if (_grade_to_sign > 150 || _grade_to_execute > 150)
         throw AForm::GradeTooLowException();
 }
 
-// Copy constructor
+// Copy constructor - a copy starts with no handle owners and no quorum
 AForm::AForm(const AForm &src)
-    : name(src.name), is_signed(src.is_signed), grade_to_sign(src.grade_to_sign), grade_to_execute(src.grade_to_execute) {
+    : name(src.name), is_signed(src.getIsSigned()), grade_to_sign(src.grade_to_sign),
+      grade_to_execute(src.grade_to_execute), ref_count(0), quorum(NULL) {
 }
 
-// Assignment operator
+// Assignment operator - protected, see AForm.hpp
 AForm &AForm::operator=(const AForm &src) {
     if (this == &src)
         return *this;
     
-    // Only copy non-const member
-    this->is_signed = src.is_signed;
+    this->name = src.name;
+    this->is_signed = src.getIsSigned();
+    this->grade_to_sign = src.grade_to_sign;
+    this->grade_to_execute = src.grade_to_execute;
     return (*this);
 }
 
@@ -35,14 +42,21 @@ AForm::~AForm() {
 }
 
 // Getters
-std::string AForm::getName() const {
+const std::string &AForm::getName() const {
     return name;
 }
 
+// Under a quorum the form is signed the moment the last signature counts
 bool AForm::getIsSigned() const {
+    if (quorum)
+        return quorum->isReached();
     return is_signed;
 }
 
+bool AForm::requiresQuorum() const {
+    return quorum != NULL;
+}
+
 int AForm::getGradeToSign() const {
     return grade_to_sign;
 }
@@ -53,17 +67,43 @@ int AForm::getGradeToExecute() const {
 
 // Member function to sign the form
 void AForm::beSigned(const Bureaucrat &bureaucrat) {
-    if (bureaucrat.getGrade() > this->grade_to_sign)
+    if (quorum) {
+        FORM_TRACE4(sign, name.c_str(), grade_to_sign, bureaucrat.getGrade(), 0);
+        throw AForm::QuorumRequiredException();
+    }
+    if (bureaucrat.getGrade() > this->grade_to_sign) {
+        FORM_TRACE4(sign, name.c_str(), grade_to_sign, bureaucrat.getGrade(), 0);
         throw AForm::GradeTooLowException();
+    }
     this->is_signed = true;
+    FORM_TRACE4(sign, name.c_str(), grade_to_sign, bureaucrat.getGrade(), 1);
+}
+
+// Execute and report the outcome - most forms cannot fail once executed
+bool AForm::perform(Bureaucrat const &executor) const {
+    execute(executor);
+    return true;
 }
 
 // Protected method to check execution requirements
 void AForm::checkExecution(const Bureaucrat &executor) const {
-    if (!this->is_signed)
+    if (!getIsSigned()) {
+        FORM_TRACE4(check_execution, name.c_str(), grade_to_execute, executor.getGrade(), 1);
         throw AForm::FormNotSignedException();
-    if (executor.getGrade() > this->grade_to_execute)
+    }
+    if (executor.getGrade() > this->grade_to_execute) {
+        FORM_TRACE4(check_execution, name.c_str(), grade_to_execute, executor.getGrade(), 2);
         throw AForm::GradeTooLowException();
+    }
+    FORM_TRACE4(check_execution, name.c_str(), grade_to_execute, executor.getGrade(), 0);
+}
+
+// Exchange every base member without copying the name
+void AForm::swap(AForm &other) {
+    name.swap(other.name);
+    std::swap(is_signed, other.is_signed);
+    std::swap(grade_to_sign, other.grade_to_sign);
+    std::swap(grade_to_execute, other.grade_to_execute);
 }
 
 // Exception implementations
@@ -79,6 +119,10 @@ const char *AForm::FormNotSignedException::what() const throw() {
     return "Form is not signed!";
 }
 
+const char *AForm::QuorumRequiredException::what() const throw() {
+    return "Form is signed by quorum only!";
+}
+
 // Insertion operator overload
 std::ostream &operator<<(std::ostream &out, const AForm &src) {
     out << "AForm " << src.getName()
@@ -0,0 +1,244 @@
+#include "BureaucracySnapshot.hpp"
+#include "Bureaucrat.hpp"
+#include "Intern.hpp"
+#include <fstream>
+#include <map>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const char SNAPSHOT_MAGIC[8] = {'B', 'U', 'R', 'S', 'N', 'A', 'P', '1'};
+
+// Add a string to the table once and return its offset
+static uint32_t internString(std::string &strings, std::map<std::string, uint32_t> &offsets,
+                             const std::string &value) {
+    std::map<std::string, uint32_t>::iterator it = offsets.find(value);
+    if (it != offsets.end())
+        return it->second;
+    uint32_t offset = strings.size();
+    strings += value;
+    offsets[value] = offset;
+    return offset;
+}
+
+// True if count records of record_size bytes at offset lie inside the
+// file. Written so that no crafted offset or count can overflow.
+static bool sectionFits(uint64_t offset, uint64_t count, size_t record_size, size_t size) {
+    return offset <= size && count <= (size - offset) / record_size;
+}
+
+// Records are read in place, so their section must be aligned for them;
+// the mapping itself starts on a page boundary
+static bool sectionAligned(uint64_t offset, size_t alignment) {
+    return offset % alignment == 0;
+}
+
+// Constructor - maps the file and checks the header only
+BureaucracySnapshot::BureaucracySnapshot(const std::string &path)
+    : data(NULL), size(0), header(NULL) {
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat info;
+
+    if (fd < 0)
+        throw BureaucracySnapshot::FileException();
+    if (fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        close(fd);
+        throw BureaucracySnapshot::CorruptSnapshotException();
+    }
+    size = info.st_size;
+    void *memory = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+        throw BureaucracySnapshot::FileException();
+    data = static_cast<const char *>(memory);
+    header = reinterpret_cast<const Header *>(data);
+
+    if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0
+        || !sectionFits(header->bureaucrat_offset, header->bureaucrat_count, sizeof(BureaucratRecord), size)
+        || !sectionFits(header->form_offset, header->form_count, sizeof(FormRecord), size)
+        || !sectionFits(header->strings_offset, header->strings_size, 1, size)
+        || !sectionAligned(header->bureaucrat_offset, __alignof__(BureaucratRecord))
+        || !sectionAligned(header->form_offset, __alignof__(FormRecord))) {
+        unmap();
+        throw BureaucracySnapshot::CorruptSnapshotException();
+    }
+    checked_bureaucrat_pages.resize(header->bureaucrat_count * sizeof(BureaucratRecord) / PAGE_SIZE + 1);
+    checked_form_pages.resize(header->form_count * sizeof(FormRecord) / PAGE_SIZE + 1);
+}
+
+// Destructor
+BureaucracySnapshot::~BureaucracySnapshot() {
+    unmap();
+}
+
+void BureaucracySnapshot::unmap() {
+    if (data)
+        munmap(const_cast<char *>(data), size);
+    data = NULL;
+    header = NULL;
+}
+
+// Write the roster, the forms and their interned strings in one file
+void BureaucracySnapshot::save(const std::string &path, const std::vector<Bureaucrat *> &roster,
+                               const std::vector<AForm *> &forms) {
+    std::vector<BureaucratRecord> bureaucrat_records(roster.size());
+    std::vector<FormRecord> form_records(forms.size());
+    std::map<std::string, uint32_t> offsets;
+    std::string strings;
+
+    for (size_t i = 0; i < roster.size(); i++) {
+        bureaucrat_records[i].name_offset = internString(strings, offsets, roster[i]->getName());
+        bureaucrat_records[i].name_length = roster[i]->getName().size();
+        bureaucrat_records[i].grade = roster[i]->getGrade();
+    }
+    for (size_t i = 0; i < forms.size(); i++) {
+        int typeId = Intern::getFormTypeId(*forms[i]);
+        if (typeId < 0)
+            throw Intern::FormNotFoundException();
+        form_records[i].target_offset = internString(strings, offsets, forms[i]->getTarget());
+        form_records[i].target_length = forms[i]->getTarget().size();
+        form_records[i].type_id = typeId;
+        form_records[i].is_signed = forms[i]->getIsSigned();
+        form_records[i].grade_to_sign = forms[i]->getGradeToSign();
+        form_records[i].grade_to_execute = forms[i]->getGradeToExecute();
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.bureaucrat_count = roster.size();
+    header.form_count = forms.size();
+    header.bureaucrat_offset = sizeof(Header);
+    header.form_offset = header.bureaucrat_offset + roster.size() * sizeof(BureaucratRecord);
+    header.strings_offset = header.form_offset + forms.size() * sizeof(FormRecord);
+    header.strings_size = strings.size();
+
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        throw BureaucracySnapshot::FileException();
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (!roster.empty())
+        file.write(reinterpret_cast<const char *>(&bureaucrat_records[0]),
+                   roster.size() * sizeof(BureaucratRecord));
+    if (!forms.empty())
+        file.write(reinterpret_cast<const char *>(&form_records[0]),
+                   forms.size() * sizeof(FormRecord));
+    file.write(strings.data(), strings.size());
+    if (!file)
+        throw BureaucracySnapshot::FileException();
+}
+
+// Lazy validation
+void BureaucracySnapshot::checkString(uint32_t offset, uint32_t length) const {
+    if (static_cast<uint64_t>(offset) + length > header->strings_size)
+        throw BureaucracySnapshot::CorruptSnapshotException();
+}
+
+const BureaucracySnapshot::BureaucratRecord &BureaucracySnapshot::bureaucratRecord(size_t index) {
+    if (index >= header->bureaucrat_count)
+        throw BureaucracySnapshot::IndexOutOfRangeException();
+    const BureaucratRecord *records
+        = reinterpret_cast<const BureaucratRecord *>(data + header->bureaucrat_offset);
+    size_t page = index * sizeof(BureaucratRecord) / PAGE_SIZE;
+
+    if (!checked_bureaucrat_pages[page]) {
+        size_t first = page * PAGE_SIZE / sizeof(BureaucratRecord);
+        size_t last = (page + 1) * PAGE_SIZE / sizeof(BureaucratRecord);
+        for (size_t i = first; i < last && i < header->bureaucrat_count; i++) {
+            checkString(records[i].name_offset, records[i].name_length);
+            if (records[i].grade < 1 || records[i].grade > 150)
+                throw BureaucracySnapshot::CorruptSnapshotException();
+        }
+        checked_bureaucrat_pages[page] = true;
+    }
+    return records[index];
+}
+
+const BureaucracySnapshot::FormRecord &BureaucracySnapshot::formRecord(size_t index) {
+    if (index >= header->form_count)
+        throw BureaucracySnapshot::IndexOutOfRangeException();
+    const FormRecord *records = reinterpret_cast<const FormRecord *>(data + header->form_offset);
+    size_t page = index * sizeof(FormRecord) / PAGE_SIZE;
+
+    if (!checked_form_pages[page]) {
+        size_t first = page * PAGE_SIZE / sizeof(FormRecord);
+        size_t last = (page + 1) * PAGE_SIZE / sizeof(FormRecord);
+        for (size_t i = first; i < last && i < header->form_count; i++) {
+            checkString(records[i].target_offset, records[i].target_length);
+            if (records[i].type_id >= Intern::FORM_TYPE_COUNT
+                || records[i].grade_to_sign < 1 || records[i].grade_to_sign > 150
+                || records[i].grade_to_execute < 1 || records[i].grade_to_execute > 150)
+                throw BureaucracySnapshot::CorruptSnapshotException();
+        }
+        checked_form_pages[page] = true;
+    }
+    return records[index];
+}
+
+// Roster access
+size_t BureaucracySnapshot::getBureaucratCount() const {
+    return header->bureaucrat_count;
+}
+
+std::string BureaucracySnapshot::getBureaucratName(size_t index) {
+    const BureaucratRecord &record = bureaucratRecord(index);
+    return std::string(data + header->strings_offset + record.name_offset, record.name_length);
+}
+
+int BureaucracySnapshot::getBureaucratGrade(size_t index) {
+    return bureaucratRecord(index).grade;
+}
+
+// Materialize a Bureaucrat - the caller owns it
+Bureaucrat *BureaucracySnapshot::makeBureaucrat(size_t index) {
+    return new Bureaucrat(getBureaucratName(index), getBureaucratGrade(index));
+}
+
+// Form access
+size_t BureaucracySnapshot::getFormCount() const {
+    return header->form_count;
+}
+
+int BureaucracySnapshot::getFormTypeId(size_t index) {
+    return formRecord(index).type_id;
+}
+
+std::string BureaucracySnapshot::getFormTarget(size_t index) {
+    const FormRecord &record = formRecord(index);
+    return std::string(data + header->strings_offset + record.target_offset, record.target_length);
+}
+
+bool BureaucracySnapshot::getFormIsSigned(size_t index) {
+    return formRecord(index).is_signed != 0;
+}
+
+// Materialize a form with its saved grades and signed state - the caller
+// owns it. The snapshot does not know who signed the form, so a signed
+// form is signed again by the weakest bureaucrat its saved grade allows.
+// The graded Intern::makeForm is static, so no Intern is hired per form.
+AForm *BureaucracySnapshot::makeForm(size_t index) {
+    const FormRecord &record = formRecord(index);
+    AForm *form = Intern::makeForm(record.type_id, getFormTarget(index),
+                                   record.grade_to_sign, record.grade_to_execute);
+
+    if (record.is_signed) {
+        Bureaucrat signer("Snapshot signer", record.grade_to_sign);
+        form->beSigned(signer);
+    }
+    return form;
+}
+
+// Exception implementations
+const char *BureaucracySnapshot::FileException::what() const throw() {
+    return "Could not access snapshot file!";
+}
+
+const char *BureaucracySnapshot::CorruptSnapshotException::what() const throw() {
+    return "Snapshot file is corrupt!";
+}
+
+const char *BureaucracySnapshot::IndexOutOfRangeException::what() const throw() {
+    return "Snapshot index out of range!";
+}
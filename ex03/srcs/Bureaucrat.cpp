@@ -1,5 +1,7 @@
 #include "Bureaucrat.hpp"
 #include "AForm.hpp"
+#include "FormDescriptor.hpp"
+#include "ExecutionQueue.hpp"
 
 // Default constructor
 Bureaucrat::Bureaucrat() : name("none"), grade(150) {
@@ -21,6 +23,7 @@ Bureaucrat &Bureaucrat::operator=(const Bureaucrat &src) {
         return *this;
     
     setGrade(src.getGrade());
+    name = src.name;
     return (*this);
 }
 
@@ -30,7 +33,7 @@ Bureaucrat::~Bureaucrat() {
 }
 
 // Getters
-std::string Bureaucrat::getName() const {
+const std::string &Bureaucrat::getName() const {
     return name;
 }
 
@@ -48,6 +51,12 @@ void Bureaucrat::setGrade(int _grade) {
     grade = _grade;
 }
 
+// Exchange name and grade without copying the name
+void Bureaucrat::swap(Bureaucrat &other) {
+    name.swap(other.name);
+    std::swap(grade, other.grade);
+}
+
 // Increment grade (decrease number)
 void Bureaucrat::incrementGrade() {
     if (grade - 1 < 1)
@@ -74,6 +83,43 @@ void Bureaucrat::signForm(AForm &form) {
     }
 }
 
+// Sign a whole batch or none of it. Every form is validated first, then
+// all of them are signed in one pass; on rejection no form is touched and
+// reasons holds one "name: reason" entry per rejected form.
+bool Bureaucrat::signForms(const std::vector<AForm *> &forms, std::vector<std::string> &reasons) {
+    std::vector<int> required(forms.size());
+    size_t rejected = 0;
+
+    reasons.clear();
+    for (size_t i = 0; i < forms.size(); i++)
+        required[i] = forms[i]->getGradeToSign();
+    // Branch-free count over contiguous grades
+    for (size_t i = 0; i < required.size(); i++)
+        rejected += this->grade > required[i];
+    for (size_t i = 0; i < forms.size(); i++)
+        rejected += forms[i]->requiresQuorum();
+
+    if (rejected) {
+        AForm::GradeTooLowException tooLow;
+        AForm::QuorumRequiredException quorumOnly;
+        reasons.reserve(rejected);
+        for (size_t i = 0; i < required.size(); i++) {
+            if (this->grade > required[i])
+                reasons.push_back(forms[i]->getName() + ": " + tooLow.what());
+            if (forms[i]->requiresQuorum())
+                reasons.push_back(forms[i]->getName() + ": " + quorumOnly.what());
+        }
+        std::cout << this->name << " couldn't sign the batch because " << rejected
+                  << " of " << forms.size() << " forms were rejected" << std::endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < forms.size(); i++)
+        forms[i]->beSigned(*this);
+    std::cout << this->name << " signed a batch of " << forms.size() << " forms" << std::endl;
+    return true;
+}
+
 // Execute a form
 void Bureaucrat::executeForm(AForm const &form) const {
     try {
@@ -86,6 +132,49 @@ void Bureaucrat::executeForm(AForm const &form) const {
     }
 }
 
+// Same as signForm/executeForm, for forms not materialized yet
+void Bureaucrat::signForm(FormDescriptor &form) {
+    try {
+        form.beSigned(*this);
+        std::cout << this->name << " signed " << form.getName() << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cout << this->name << " couldn't sign " << form.getName()
+                  << " because " << e.what() << std::endl;
+    }
+}
+
+void Bureaucrat::executeForm(FormDescriptor const &form) const {
+    try {
+        form.execute(*this);
+        std::cout << this->name << " executed " << form.getName() << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cout << this->name << " couldn't execute " << form.getName()
+                  << " because " << e.what() << std::endl;
+    }
+}
+
+// Execute a form like executeForm, and report whether its action succeeded
+bool Bureaucrat::performForm(AForm const &form) const {
+    try {
+        bool succeeded = form.perform(*this);
+        std::cout << this->name << " executed " << form.getName() << std::endl;
+        return succeeded;
+    }
+    catch (std::exception &e) {
+        std::cout << this->name << " couldn't execute " << form.getName()
+                  << " because " << e.what() << std::endl;
+    }
+    return false;
+}
+
+// Execute a form on the queue's workers and return at once; the ticket
+// collects the outcome, including FormNotSignedException
+ExecutionTicket Bureaucrat::executeFormAsync(AForm const &form, ExecutionQueue &queue) const {
+    return queue.submit(form, *this);
+}
+
 // Exception implementations
 const char *Bureaucrat::GradeTooHighException::what() const throw() {
     return "Bureaucrat grade is too high!";
@@ -97,6 +186,10 @@ const char *Bureaucrat::GradeTooLowException::what() const throw() {
 
 // Insertion operator overload
 std::ostream &operator<<(std::ostream &out, const Bureaucrat &src) {
-    out << src.name << ", bureaucrat grade " << src.grade;
+    out << src.getName() << ", bureaucrat grade " << src.getGrade();
     return out;
 }
+
+void swap(Bureaucrat &a, Bureaucrat &b) {
+    a.swap(b);
+}
@@ -0,0 +1,153 @@
+#include "EpochReclaimer.hpp"
+#include "AForm.hpp"
+#include "FormHandle.hpp"
+#include <sched.h>
+
+// Guard constructor/destructor
+EpochReclaimer::Guard::Guard(EpochReclaimer &_reclaimer, int _slot)
+    : reclaimer(_reclaimer), slot(_slot) {
+    reclaimer.enter(slot);
+}
+
+EpochReclaimer::Guard::~Guard() {
+    reclaimer.leave(slot);
+}
+
+// Default constructor
+EpochReclaimer::EpochReclaimer() : global_epoch(0), lock(0), reclaimed(0) {
+    for (int i = 0; i < MAX_READERS; i++) {
+        readers[i].epoch = 0;
+        readers[i].active = 0;
+        readers[i].in_use = 0;
+    }
+}
+
+// Destructor
+EpochReclaimer::~EpochReclaimer() {
+    for (int i = 0; i < EPOCH_COUNT; i++)
+        freeAll(limbo[i]);
+}
+
+// Getters
+unsigned long EpochReclaimer::getEpoch() const {
+    return global_epoch;
+}
+
+size_t EpochReclaimer::getPendingCount() {
+    size_t pending = 0;
+
+    acquireLock();
+    for (int i = 0; i < EPOCH_COUNT; i++)
+        pending += limbo[i].size();
+    releaseLock();
+    return pending;
+}
+
+unsigned long EpochReclaimer::getReclaimedCount() const {
+    return reclaimed;
+}
+
+// Private helpers
+void EpochReclaimer::acquireLock() {
+    while (__sync_lock_test_and_set(&lock, 1))
+        sched_yield();
+}
+
+void EpochReclaimer::releaseLock() {
+    __sync_lock_release(&lock);
+}
+
+void EpochReclaimer::freeAll(std::vector<Retired> &objects) {
+    for (size_t i = 0; i < objects.size(); i++)
+        objects[i].deleter(objects[i].object);
+    objects.clear();
+}
+
+void EpochReclaimer::deleteForm(void *object) {
+    delete static_cast<AForm *>(object);
+}
+
+// Claim a free reader slot
+int EpochReclaimer::registerReader() {
+    for (int i = 0; i < MAX_READERS; i++) {
+        if (__sync_bool_compare_and_swap(&readers[i].in_use, 0, 1))
+            return i;
+    }
+    throw EpochReclaimer::TooManyReadersException();
+}
+
+void EpochReclaimer::unregisterReader(int slot) {
+    if (slot < 0 || slot >= MAX_READERS)
+        throw EpochReclaimer::InvalidSlotException();
+    readers[slot].active = 0;
+    __sync_synchronize();
+    readers[slot].in_use = 0;
+}
+
+// Announce the current epoch before touching shared forms
+void EpochReclaimer::enter(int slot) {
+    if (slot < 0 || slot >= MAX_READERS)
+        throw EpochReclaimer::InvalidSlotException();
+    readers[slot].active = 1;
+    __sync_synchronize();
+    readers[slot].epoch = global_epoch;
+    __sync_synchronize();
+}
+
+void EpochReclaimer::leave(int slot) {
+    if (slot < 0 || slot >= MAX_READERS)
+        throw EpochReclaimer::InvalidSlotException();
+    __sync_synchronize();
+    readers[slot].active = 0;
+}
+
+// Hand over an unpublished form - it is deleted once no reader can see it
+void EpochReclaimer::retire(AForm *form) {
+    if (form && FormHandle::isBorrowed(*form))
+        throw FormHandle::BorrowedFormException();
+    retire(form, &EpochReclaimer::deleteForm);
+}
+
+void EpochReclaimer::retire(void *object, Deleter deleter) {
+    Retired retired;
+    retired.object = object;
+    retired.deleter = deleter;
+
+    acquireLock();
+    limbo[global_epoch % EPOCH_COUNT].push_back(retired);
+    releaseLock();
+}
+
+// Advance the epoch if every active reader has caught up, then free the
+// batch retired two epochs ago. Returns the number of objects freed.
+size_t EpochReclaimer::tryReclaim() {
+    std::vector<Retired> expired;
+
+    acquireLock();
+    unsigned long epoch = global_epoch;
+    __sync_synchronize();
+    for (int i = 0; i < MAX_READERS; i++) {
+        if (readers[i].active && readers[i].epoch != epoch) {
+            releaseLock();
+            return 0;
+        }
+    }
+    global_epoch = epoch + 1;
+    __sync_synchronize();
+    expired.swap(limbo[(epoch + 1) % EPOCH_COUNT]);
+    releaseLock();
+
+    size_t count = expired.size();
+    freeAll(expired);
+    __sync_add_and_fetch(&reclaimed, count);
+    return count;
+}
+
+// Exception implementations
+const char *EpochReclaimer::TooManyReadersException::what() const throw() {
+    return "No free reader slot!";
+}
+
+const char *EpochReclaimer::InvalidSlotException::what() const throw() {
+    return "Invalid reader slot!";
+}
@@ -0,0 +1,184 @@
+#include "ExecutionCache.hpp"
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+#include "Intern.hpp"
+
+// Cache lock
+ExecutionCache::Lock::Lock(const ExecutionCache &cache) : mutex(cache.mutex) {
+    pthread_mutex_lock(&mutex);
+}
+
+ExecutionCache::Lock::~Lock() {
+    pthread_mutex_unlock(&mutex);
+}
+
+// Default constructor
+ExecutionCache::ExecutionCache()
+    : capacity(1024), ttl(60), hits(0), misses(0), evictions(0) {
+    pthread_mutex_init(&mutex, NULL);
+}
+
+// Parameterized constructor - a ttl of 0 keeps entries until evicted
+ExecutionCache::ExecutionCache(size_t _capacity, std::time_t _ttl)
+    : capacity(_capacity), ttl(_ttl), hits(0), misses(0), evictions(0) {
+    if (_capacity == 0)
+        throw ExecutionCache::InvalidCapacityException();
+    pthread_mutex_init(&mutex, NULL);
+}
+
+// Copy constructor
+ExecutionCache::ExecutionCache(const ExecutionCache &src) {
+    pthread_mutex_init(&mutex, NULL);
+    Lock lock(src);
+    copyFrom(src);
+}
+
+// Assignment operator
+ExecutionCache &ExecutionCache::operator=(const ExecutionCache &src) {
+    if (this == &src)
+        return *this;
+
+    ExecutionCache copy(src);
+    Lock lock(*this);
+    copyFrom(copy);
+    return *this;
+}
+
+// Destructor
+ExecutionCache::~ExecutionCache() {
+    pthread_mutex_destroy(&mutex);
+}
+
+// Getters
+size_t ExecutionCache::getSize() const {
+    Lock lock(*this);
+    return index.size();
+}
+
+size_t ExecutionCache::getCapacity() const {
+    return capacity;
+}
+
+std::time_t ExecutionCache::getTtl() const {
+    return ttl;
+}
+
+unsigned long ExecutionCache::getHits() const {
+    Lock lock(*this);
+    return hits;
+}
+
+unsigned long ExecutionCache::getMisses() const {
+    Lock lock(*this);
+    return misses;
+}
+
+unsigned long ExecutionCache::getEvictions() const {
+    Lock lock(*this);
+    return evictions;
+}
+
+// Private helpers
+bool ExecutionCache::makeKey(const AForm &form, Key &key) {
+    int typeId = Intern::getFormTypeId(form);
+
+    if (typeId < 0 || !Intern::isDeterministic(typeId))
+        return false;
+    key = static_cast<Key>(typeId) << 32 | form.getTargetHandle();
+    return true;
+}
+
+bool ExecutionCache::isFresh(EntryIndex::const_iterator it, std::time_t now) const {
+    return it->second->expires == 0 || now < it->second->expires;
+}
+
+// The index points into our own list, so it is rebuilt; caller holds
+// the lock of src
+void ExecutionCache::copyFrom(const ExecutionCache &src) {
+    entries = src.entries;
+    index.clear();
+    for (EntryList::iterator it = entries.begin(); it != entries.end(); ++it)
+        index[it->key] = it;
+    capacity = src.capacity;
+    ttl = src.ttl;
+    hits = src.hits;
+    misses = src.misses;
+    evictions = src.evictions;
+}
+
+// Caller holds the lock
+void ExecutionCache::insert(Key key, std::time_t now) {
+    EntryIndex::iterator it = index.find(key);
+    if (it != index.end()) {
+        entries.erase(it->second);
+        index.erase(it);
+    }
+    if (index.size() >= capacity) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+        evictions++;
+    }
+    Entry entry;
+    entry.key = key;
+    entry.expires = ttl ? now + ttl : 0;
+    entries.push_front(entry);
+    index[key] = entries.begin();
+}
+
+// Execute the form unless the same (type, target) was executed within ttl.
+// Signature and grade are still checked on a hit; returns true if the form
+// was actually executed.
+bool ExecutionCache::execute(const AForm &form, const Bureaucrat &executor) {
+    Key key;
+    std::time_t now = std::time(NULL);
+
+    if (!makeKey(form, key)) {
+        form.execute(executor);
+        return true;
+    }
+    {
+        Lock lock(*this);
+        EntryIndex::iterator it = index.find(key);
+        if (it != index.end() && isFresh(it, now)) {
+            form.checkExecution(executor);
+            entries.splice(entries.begin(), entries, it->second);
+            hits++;
+            return false;
+        }
+        misses++;
+    }
+    form.execute(executor);
+    Lock lock(*this);
+    insert(key, now);
+    return true;
+}
+
+bool ExecutionCache::contains(const AForm &form) const {
+    Key key;
+    if (!makeKey(form, key))
+        return false;
+
+    Lock lock(*this);
+    EntryIndex::const_iterator it = index.find(key);
+    return it != index.end() && isFresh(it, std::time(NULL));
+}
+
+void ExecutionCache::clear() {
+    Lock lock(*this);
+    entries.clear();
+    index.clear();
+}
+
+// Exception implementation
+const char *ExecutionCache::InvalidCapacityException::what() const throw() {
+    return "Cache capacity must be at least 1!";
+}
+
+// Insertion operator overload
+std::ostream &operator<<(std::ostream &out, const ExecutionCache &src) {
+    out << "ExecutionCache " << src.getSize() << "/" << src.getCapacity()
+        << ", hits: " << src.getHits()
+        << ", misses: " << src.getMisses()
+        << ", evictions: " << src.getEvictions();
+    return out;
+}
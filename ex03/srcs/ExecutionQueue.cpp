@@ -0,0 +1,222 @@
+#include "ExecutionQueue.hpp"
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+#include <stdexcept>
+
+// Result default constructor
+ExecutionQueue::Result::Result() : status(PENDING), error(NO_ERROR) {
+}
+
+// Re-raise the failure on the caller's side, keeping its original type
+void ExecutionQueue::Result::rethrow() const {
+    switch (error) {
+    case FORM_NOT_SIGNED:
+        throw AForm::FormNotSignedException();
+    case GRADE_TOO_LOW:
+        throw AForm::GradeTooLowException();
+    case OTHER_ERROR:
+        throw std::runtime_error(message);
+    default:
+        break;
+    }
+}
+
+// Constructor - starts the workers; at least one must start
+ExecutionQueue::ExecutionQueue(size_t worker_count)
+    : next_job(0), next_delivery(0), delivering(false), stopping(false) {
+    pthread_mutex_init(&lock, NULL);
+    pthread_cond_init(&work_ready, NULL);
+    pthread_cond_init(&delivered, NULL);
+    for (size_t i = 0; i < worker_count; i++) {
+        pthread_t worker;
+        if (pthread_create(&worker, NULL, workerLoop, this) != 0)
+            break;
+        workers.push_back(worker);
+    }
+    if (workers.empty()) {
+        pthread_cond_destroy(&delivered);
+        pthread_cond_destroy(&work_ready);
+        pthread_mutex_destroy(&lock);
+        throw ExecutionQueue::ThreadStartException();
+    }
+}
+
+// Destructor - finish and deliver everything, then stop the workers
+ExecutionQueue::~ExecutionQueue() {
+    waitAll();
+    pthread_mutex_lock(&lock);
+    stopping = true;
+    pthread_cond_broadcast(&work_ready);
+    pthread_mutex_unlock(&lock);
+    for (size_t i = 0; i < workers.size(); i++)
+        pthread_join(workers[i], NULL);
+    for (size_t i = 0; i < jobs.size(); i++)
+        delete jobs[i];
+    pthread_cond_destroy(&delivered);
+    pthread_cond_destroy(&work_ready);
+    pthread_mutex_destroy(&lock);
+}
+
+// Getters
+size_t ExecutionQueue::getWorkerCount() const {
+    return workers.size();
+}
+
+// Jobs whose result has not been delivered yet
+size_t ExecutionQueue::getPendingCount() const {
+    pthread_mutex_lock(&lock);
+    size_t pending = jobs.size() - next_delivery;
+    pthread_mutex_unlock(&lock);
+    return pending;
+}
+
+const ExecutionQueue::Job &ExecutionQueue::getJob(Ticket ticket) const {
+    pthread_mutex_lock(&lock);
+    bool valid = ticket.id < jobs.size();
+    const Job *job = valid ? jobs[ticket.id] : NULL;
+    pthread_mutex_unlock(&lock);
+    if (!valid)
+        throw ExecutionQueue::InvalidTicketException();
+    return *job;
+}
+
+bool ExecutionQueue::isDone(Ticket ticket) const {
+    pthread_mutex_lock(&lock);
+    bool valid = ticket.id < jobs.size();
+    bool done = ticket.id < next_delivery;
+    pthread_mutex_unlock(&lock);
+    if (!valid)
+        throw ExecutionQueue::InvalidTicketException();
+    return done;
+}
+
+// The result is final once isDone() is true; before that it reads PENDING
+const ExecutionQueue::Result &ExecutionQueue::getResult(Ticket ticket) const {
+    static const Result pending;
+    const Job &job = getJob(ticket);
+
+    return isDone(ticket) ? job.result : pending;
+}
+
+// Queue an execution - form and executor must outlive the job
+ExecutionQueue::Ticket ExecutionQueue::submit(const AForm &form, const Bureaucrat &executor,
+                                              Callback callback, void *data) {
+    Job *job = new Job;
+    Ticket ticket;
+
+    job->form = &form;
+    job->executor = &executor;
+    job->callback = callback;
+    job->data = data;
+    job->finished = false;
+    pthread_mutex_lock(&lock);
+    try {
+        jobs.push_back(job);
+    }
+    catch (...) {
+        pthread_mutex_unlock(&lock);
+        delete job;
+        throw;
+    }
+    ticket.id = jobs.size() - 1;
+    pthread_cond_signal(&work_ready);
+    pthread_mutex_unlock(&lock);
+    return ticket;
+}
+
+// Block until the ticket's result, and every earlier one, is delivered
+const ExecutionQueue::Result &ExecutionQueue::wait(Ticket ticket) {
+    const Job &job = getJob(ticket);
+
+    pthread_mutex_lock(&lock);
+    while (next_delivery <= ticket.id)
+        pthread_cond_wait(&delivered, &lock);
+    pthread_mutex_unlock(&lock);
+    return job.result;
+}
+
+void ExecutionQueue::waitAll() {
+    pthread_mutex_lock(&lock);
+    while (next_delivery < jobs.size())
+        pthread_cond_wait(&delivered, &lock);
+    pthread_mutex_unlock(&lock);
+}
+
+// Execute one job, reporting it the same way Bureaucrat::executeForm does
+ExecutionQueue::Result ExecutionQueue::runJob(const Job &job) {
+    Result result;
+
+    try {
+        job.form->execute(*job.executor);
+        result.status = DONE;
+        std::cout << job.executor->getName() << " executed " << job.form->getName() << std::endl;
+        return result;
+    }
+    catch (AForm::FormNotSignedException &e) {
+        result.error = FORM_NOT_SIGNED;
+        result.message = e.what();
+    }
+    catch (AForm::GradeTooLowException &e) {
+        result.error = GRADE_TOO_LOW;
+        result.message = e.what();
+    }
+    catch (std::exception &e) {
+        result.error = OTHER_ERROR;
+        result.message = e.what();
+    }
+    result.status = FAILED;
+    std::cout << job.executor->getName() << " couldn't execute " << job.form->getName()
+              << " because " << result.message << std::endl;
+    return result;
+}
+
+// Worker: take jobs in submission order and execute them outside the lock
+void *ExecutionQueue::workerLoop(void *arg) {
+    ExecutionQueue &queue = *static_cast<ExecutionQueue *>(arg);
+
+    pthread_mutex_lock(&queue.lock);
+    while (true) {
+        while (queue.next_job == queue.jobs.size() && !queue.stopping)
+            pthread_cond_wait(&queue.work_ready, &queue.lock);
+        if (queue.next_job == queue.jobs.size())
+            break;
+        Job &job = *queue.jobs[queue.next_job++];
+        pthread_mutex_unlock(&queue.lock);
+        Result result = runJob(job);
+        pthread_mutex_lock(&queue.lock);
+        job.result = result;
+        job.finished = true;
+        queue.deliver();
+    }
+    pthread_mutex_unlock(&queue.lock);
+    return NULL;
+}
+
+// Called with the lock held. One worker at a time hands out the finished
+// jobs at the front of the queue, so callbacks keep submission order; the
+// lock is released around each callback so it may submit more jobs.
+void ExecutionQueue::deliver() {
+    if (delivering)
+        return;
+    delivering = true;
+    while (next_delivery < jobs.size() && jobs[next_delivery]->finished) {
+        Job &job = *jobs[next_delivery];
+        if (job.callback) {
+            pthread_mutex_unlock(&lock);
+            job.callback(*job.form, job.result, job.data);
+            pthread_mutex_lock(&lock);
+        }
+        next_delivery++;
+        pthread_cond_broadcast(&delivered);
+    }
+    delivering = false;
+}
+
+// Exception implementations
+const char *ExecutionQueue::InvalidTicketException::what() const throw() {
+    return "Invalid execution ticket!";
+}
+
+const char *ExecutionQueue::ThreadStartException::what() const throw() {
+    return "Cannot start execution workers!";
+}
@@ -0,0 +1,51 @@
+#include "FormBatch.hpp"
+#include "AForm.hpp"
+#include <new>
+
+// Default constructor - empty batch
+FormBatch::FormBatch() : storage(NULL), forms(NULL), count(0) {
+}
+
+// Destructor
+FormBatch::~FormBatch() {
+    clear();
+}
+
+// View
+size_t FormBatch::size() const {
+    return count;
+}
+
+bool FormBatch::empty() const {
+    return count == 0;
+}
+
+AForm &FormBatch::operator[](size_t index) const {
+    return *forms[index];
+}
+
+FormBatch::const_iterator FormBatch::begin() const {
+    return forms;
+}
+
+FormBatch::const_iterator FormBatch::end() const {
+    return forms + count;
+}
+
+// Destroy every form in place, then free the buffer in one go
+void FormBatch::clear() {
+    for (size_t i = 0; i < count; i++)
+        forms[i]->~AForm();
+    ::operator delete(storage);
+    storage = NULL;
+    forms = NULL;
+    count = 0;
+}
+
+// Insertion operator overload
+std::ostream &operator<<(std::ostream &out, const FormBatch &src) {
+    out << "FormBatch of " << src.size() << " forms";
+    for (FormBatch::const_iterator it = src.begin(); it != src.end(); ++it)
+        out << "\n  " << **it << ", target: " << (*it)->getTarget();
+    return out;
+}
@@ -0,0 +1,81 @@
+#include "FormClient.hpp"
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Default constructor
+FormClient::FormClient() : fd(-1) {
+}
+
+// Destructor
+FormClient::~FormClient() {
+    disconnect();
+}
+
+// Getter
+int FormClient::getFd() const {
+    return fd;
+}
+
+void FormClient::connect(const std::string &socket_path) {
+    struct sockaddr_un address;
+
+    disconnect();
+    if (socket_path.size() >= sizeof(address.sun_path))
+        throw FormClient::ConnectionException();
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socket_path.c_str());
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        throw FormClient::ConnectionException();
+    if (::connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) < 0) {
+        disconnect();
+        throw FormClient::ConnectionException();
+    }
+}
+
+void FormClient::send(const std::string &frames) {
+    size_t sent = 0;
+
+    while (sent < frames.size()) {
+        ssize_t count = write(fd, frames.data() + sent, frames.size() - sent);
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+            throw FormClient::ConnectionException();
+        }
+        sent += count;
+    }
+}
+
+// Block until the next response frame has arrived
+void FormClient::receive(FormProtocol::Frame &frame) {
+    char buffer[4096];
+    size_t offset = 0;
+
+    while (!FormProtocol::decode(in, offset, frame)) {
+        ssize_t count = read(fd, buffer, sizeof(buffer));
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+            throw FormClient::ConnectionException();
+        in.append(buffer, count);
+    }
+    in.erase(0, offset);
+}
+
+void FormClient::disconnect() {
+    if (fd >= 0)
+        close(fd);
+    fd = -1;
+    in.clear();
+}
+
+// Exception implementation
+const char *FormClient::ConnectionException::what() const throw() {
+    return "Form service connection error!";
+}
@@ -0,0 +1,96 @@
+#include "FormDescriptor.hpp"
+#include "Intern.hpp"
+#include "Bureaucrat.hpp"
+#include "Trace.hpp"
+
+// Build a descriptor for a known form type with its compiled-in grades
+FormDescriptor FormDescriptor::make(int typeId, const std::string &target) {
+    if (typeId < 0 || typeId >= Intern::FORM_TYPE_COUNT)
+        throw Intern::FormNotFoundException();
+    return make(typeId, target, Intern::getGradeToSign(typeId), Intern::getGradeToExecute(typeId));
+}
+
+// Same, with the grades overridden, e.g. by a form type configuration
+FormDescriptor FormDescriptor::make(int typeId, const std::string &target,
+                                    int gradeToSign, int gradeToExecute) {
+    if (typeId < 0 || typeId >= Intern::FORM_TYPE_COUNT)
+        throw Intern::FormNotFoundException();
+    if (gradeToSign < 1 || gradeToExecute < 1)
+        throw AForm::GradeTooHighException();
+    if (gradeToSign > 150 || gradeToExecute > 150)
+        throw AForm::GradeTooLowException();
+
+    FormDescriptor descriptor;
+    descriptor.type_id = static_cast<unsigned char>(typeId);
+    descriptor.is_signed = 0;
+    descriptor.grade_to_sign = static_cast<unsigned char>(gradeToSign);
+    descriptor.grade_to_execute = static_cast<unsigned char>(gradeToExecute);
+    descriptor.target = TargetPool::intern(target);
+    return descriptor;
+}
+
+// Getters
+const char *FormDescriptor::getName() const {
+    return Intern::getFormClassName(type_id);
+}
+
+const std::string &FormDescriptor::getTarget() const {
+    return TargetPool::get(target);
+}
+
+int FormDescriptor::getGradeToSign() const {
+    return grade_to_sign;
+}
+
+int FormDescriptor::getGradeToExecute() const {
+    return grade_to_execute;
+}
+
+// Sign without building the form, traced like AForm::beSigned
+void FormDescriptor::beSigned(const Bureaucrat &bureaucrat) {
+    if (bureaucrat.getGrade() > getGradeToSign()) {
+        FORM_TRACE4(sign, getName(), getGradeToSign(), bureaucrat.getGrade(), 0);
+        throw AForm::GradeTooLowException();
+    }
+    is_signed = 1;
+    FORM_TRACE4(sign, getName(), getGradeToSign(), bureaucrat.getGrade(), 1);
+}
+
+// Check like AForm::checkExecution, then build, execute and drop the form
+void FormDescriptor::execute(Bureaucrat const &executor) const {
+    if (!is_signed)
+        throw AForm::FormNotSignedException();
+    if (executor.getGrade() > getGradeToExecute())
+        throw AForm::GradeTooLowException();
+
+    AForm *form = materialize();
+    try {
+        form->execute(executor);
+    }
+    catch (...) {
+        delete form;
+        throw;
+    }
+    delete form;
+}
+
+// The descriptor does not know who signed it, so a signed descriptor is
+// signed again by the weakest bureaucrat its grade allows
+AForm *FormDescriptor::materialize() const {
+    AForm *form = Intern::makeForm(type_id, getTarget(), grade_to_sign, grade_to_execute);
+
+    if (is_signed) {
+        Bureaucrat signer("Descriptor signer", grade_to_sign);
+        form->beSigned(signer);
+    }
+    return form;
+}
+
+// Insertion operator overload
+std::ostream &operator<<(std::ostream &out, const FormDescriptor &src) {
+    out << "FormDescriptor " << src.getName() << ", target: " << src.getTarget()
+        << ", signed: " << (src.is_signed ? "yes" : "no")
+        << ", grade required to sign: " << src.getGradeToSign()
+        << ", grade required to execute: " << src.getGradeToExecute();
+    return out;
+}
@@ -0,0 +1,244 @@
+#include "FormGraph.hpp"
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+#include <pthread.h>
+#include <ctime>
+
+static unsigned long long monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<unsigned long long>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+// Default constructor
+FormGraph::FormGraph() : achieved_parallelism(0.0) {
+}
+
+// Copy constructor
+FormGraph::FormGraph(const FormGraph &src)
+    : nodes(src.nodes), waves(src.waves), critical_path(src.critical_path),
+      completion_order(src.completion_order), achieved_parallelism(src.achieved_parallelism) {
+}
+
+// Assignment operator
+FormGraph &FormGraph::operator=(const FormGraph &src) {
+    if (this == &src)
+        return *this;
+
+    this->nodes = src.nodes;
+    this->waves = src.waves;
+    this->critical_path = src.critical_path;
+    this->completion_order = src.completion_order;
+    this->achieved_parallelism = src.achieved_parallelism;
+    return *this;
+}
+
+// Destructor
+FormGraph::~FormGraph() {
+}
+
+// Add a form - it must outlive the graph run. Returns its node id.
+size_t FormGraph::addForm(const AForm &form) {
+    Node node;
+    node.form = &form;
+    node.state = PENDING;
+    nodes.push_back(node);
+    return nodes.size() - 1;
+}
+
+// node may only run once dependsOn has succeeded
+void FormGraph::addDependency(size_t node, size_t dependsOn) {
+    if (node >= nodes.size() || dependsOn >= nodes.size())
+        throw FormGraph::InvalidNodeException();
+    if (node == dependsOn)
+        throw FormGraph::CycleException();
+    nodes[node].dependencies.push_back(dependsOn);
+    nodes[dependsOn].dependents.push_back(node);
+}
+
+// Kahn's algorithm by waves, tracking the longest dependency chain
+void FormGraph::plan() {
+    std::vector<size_t> remaining(nodes.size());
+    std::vector<size_t> depth(nodes.size(), 1);
+    std::vector<size_t> parent(nodes.size(), nodes.size());
+    std::vector<size_t> ready;
+    size_t planned = 0;
+
+    waves.clear();
+    critical_path.clear();
+    for (size_t i = 0; i < nodes.size(); i++) {
+        remaining[i] = nodes[i].dependencies.size();
+        if (remaining[i] == 0)
+            ready.push_back(i);
+    }
+    while (!ready.empty()) {
+        std::vector<size_t> next;
+        for (size_t i = 0; i < ready.size(); i++) {
+            const Node &node = nodes[ready[i]];
+            for (size_t j = 0; j < node.dependents.size(); j++) {
+                size_t dependent = node.dependents[j];
+                if (depth[ready[i]] + 1 > depth[dependent]) {
+                    depth[dependent] = depth[ready[i]] + 1;
+                    parent[dependent] = ready[i];
+                }
+                if (--remaining[dependent] == 0)
+                    next.push_back(dependent);
+            }
+        }
+        planned += ready.size();
+        waves.push_back(ready);
+        ready.swap(next);
+    }
+    if (planned != nodes.size()) {
+        waves.clear();
+        throw FormGraph::CycleException();
+    }
+
+    size_t deepest = 0;
+    for (size_t i = 1; i < nodes.size(); i++) {
+        if (depth[i] > depth[deepest])
+            deepest = i;
+    }
+    for (size_t i = deepest; i < nodes.size(); i = parent[i])
+        critical_path.insert(critical_path.begin(), i);
+}
+
+void FormGraph::cancelDependents(size_t node) {
+    for (size_t i = 0; i < nodes[node].dependents.size(); i++) {
+        size_t dependent = nodes[node].dependents[i];
+        if (nodes[dependent].state == PENDING) {
+            nodes[dependent].state = CANCELLED;
+            cancelDependents(dependent);
+        }
+    }
+}
+
+// Thread body: execute forms of the wave until none is left. Each form
+// is taken by exactly one thread, which alone writes its state.
+void *FormGraph::runForms(void *arg) {
+    WaveRun *run = static_cast<WaveRun *>(arg);
+    size_t index;
+
+    while ((index = __sync_fetch_and_add(&run->next, 1)) < run->forms->size()) {
+        size_t id = (*run->forms)[index];
+        Node &node = run->graph->nodes[id];
+        if (node.state == CANCELLED)
+            continue;
+        unsigned long long start = monotonicNs();
+        node.state = run->executor->performForm(*node.form) ? SUCCEEDED : FAILED;
+        __sync_fetch_and_add(run->busy_ns, monotonicNs() - start);
+        run->graph->completion_order[__sync_fetch_and_add(run->completed, 1)] = id;
+    }
+    return NULL;
+}
+
+// Run one wave on up to MAX_THREADS threads, this one included. If a
+// thread cannot be started the remaining ones pick up its share.
+void FormGraph::runWave(const std::vector<size_t> &wave, const Bureaucrat &executor,
+                        volatile size_t &completed, volatile unsigned long long &busy_ns) {
+    WaveRun run;
+    std::vector<pthread_t> threads;
+
+    run.graph = this;
+    run.forms = &wave;
+    run.executor = &executor;
+    run.next = 0;
+    run.completed = &completed;
+    run.busy_ns = &busy_ns;
+    for (size_t i = 1; i < wave.size() && i < MAX_THREADS; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, runForms, &run) != 0)
+            break;
+        threads.push_back(thread);
+    }
+    runForms(&run);
+    for (size_t i = 0; i < threads.size(); i++)
+        pthread_join(threads[i], NULL);
+}
+
+// Execute every form, wave by wave; a wave starts once the previous one
+// has finished, and failures cancel their dependents in between
+void FormGraph::run(const Bureaucrat &executor) {
+    volatile size_t completed = 0;
+    volatile unsigned long long busy_ns = 0;
+    unsigned long long start = monotonicNs();
+
+    plan();
+    for (size_t i = 0; i < nodes.size(); i++)
+        nodes[i].state = PENDING;
+    completion_order.assign(nodes.size(), 0);
+
+    for (size_t wave = 0; wave < waves.size(); wave++) {
+        for (size_t i = 0; i < waves[wave].size(); i++) {
+            const Node &node = nodes[waves[wave][i]];
+            if (node.state == CANCELLED)
+                std::cout << node.form->getName() << " cancelled: a dependency failed" << std::endl;
+        }
+        runWave(waves[wave], executor, completed, busy_ns);
+        for (size_t i = 0; i < waves[wave].size(); i++) {
+            if (nodes[waves[wave][i]].state == FAILED)
+                cancelDependents(waves[wave][i]);
+        }
+    }
+    completion_order.resize(completed);
+    unsigned long long elapsed = monotonicNs() - start;
+    achieved_parallelism = elapsed ? static_cast<double>(busy_ns) / elapsed : 0.0;
+}
+
+// Reporting
+size_t FormGraph::getFormCount() const {
+    return nodes.size();
+}
+
+FormGraph::State FormGraph::getState(size_t node) const {
+    if (node >= nodes.size())
+        throw FormGraph::InvalidNodeException();
+    return nodes[node].state;
+}
+
+size_t FormGraph::getWaveCount() const {
+    return waves.size();
+}
+
+const std::vector<size_t> &FormGraph::getCriticalPath() const {
+    return critical_path;
+}
+
+// Executed forms of the last run, in the order they finished
+const std::vector<size_t> &FormGraph::getCompletionOrder() const {
+    return completion_order;
+}
+
+// Average wave width: the most forms that could run side by side on
+// average, whatever the threads actually managed
+double FormGraph::getMaxParallelism() const {
+    if (waves.empty())
+        return 0.0;
+    return static_cast<double>(nodes.size()) / waves.size();
+}
+
+// Measured over the last run: time spent executing forms, summed over
+// threads, divided by the run's wall time - the average number of forms
+// in progress at once
+double FormGraph::getAchievedParallelism() const {
+    return achieved_parallelism;
+}
+
+// Exception implementations
+const char *FormGraph::InvalidNodeException::what() const throw() {
+    return "Invalid form graph node!";
+}
+
+const char *FormGraph::CycleException::what() const throw() {
+    return "Form dependencies contain a cycle!";
+}
+
+// Insertion operator overload
+std::ostream &operator<<(std::ostream &out, const FormGraph &src) {
+    out << "FormGraph " << src.getFormCount() << " forms in " << src.getWaveCount()
+        << " waves, parallelism " << src.getAchievedParallelism()
+        << " of " << src.getMaxParallelism() << ", critical path:";
+    for (size_t i = 0; i < src.getCriticalPath().size(); i++)
+        out << (i ? " -> " : " ") << src.getCriticalPath()[i];
+    return out;
+}
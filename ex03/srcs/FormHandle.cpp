@@ -0,0 +1,106 @@
+#include "FormHandle.hpp"
+
+// Reference count of a form no handle may own
+static const int BORROWED = -1;
+
+// Default constructor
+FormHandle::FormHandle() : form(NULL) {
+}
+
+// Parameterized constructor - takes ownership of a form from new
+FormHandle::FormHandle(AForm *_form) : form(NULL) {
+    if (_form && isBorrowed(*_form))
+        throw FormHandle::BorrowedFormException();
+    form = _form;
+    retain();
+}
+
+// Copy constructor
+FormHandle::FormHandle(const FormHandle &src) : form(src.form) {
+    retain();
+}
+
+// Assignment operator
+FormHandle &FormHandle::operator=(const FormHandle &src) {
+    if (this == &src || form == src.form)
+        return *this;
+
+    src.retain();
+    drop();
+    this->form = src.form;
+    return *this;
+}
+
+// Destructor
+FormHandle::~FormHandle() {
+    drop();
+}
+
+// Private helpers
+void FormHandle::retain() const {
+    if (form)
+        __sync_add_and_fetch(&form->ref_count, 1);
+}
+
+void FormHandle::drop() {
+    if (form && __sync_sub_and_fetch(&form->ref_count, 1) == 0)
+        delete form;
+    form = NULL;
+}
+
+// Getters
+AForm *FormHandle::get() const {
+    return form;
+}
+
+AForm &FormHandle::operator*() const {
+    if (!form)
+        throw FormHandle::NullHandleException();
+    return *form;
+}
+
+AForm *FormHandle::operator->() const {
+    if (!form)
+        throw FormHandle::NullHandleException();
+    return form;
+}
+
+bool FormHandle::isNull() const {
+    return form == NULL;
+}
+
+int FormHandle::getUseCount() const {
+    if (!form)
+        return 0;
+    return __sync_add_and_fetch(&form->ref_count, 0);
+}
+
+// Member functions
+void FormHandle::reset(AForm *_form) {
+    FormHandle replacement(_form);
+    swap(replacement);
+}
+
+void FormHandle::swap(FormHandle &other) {
+    AForm *tmp = form;
+    form = other.form;
+    other.form = tmp;
+}
+
+// Called before the form is shared, so a plain store is enough
+void FormHandle::markBorrowed(AForm &form) {
+    form.ref_count = BORROWED;
+}
+
+bool FormHandle::isBorrowed(const AForm &form) {
+    return __sync_add_and_fetch(&form.ref_count, 0) == BORROWED;
+}
+
+// Exception implementations
+const char *FormHandle::NullHandleException::what() const throw() {
+    return "Null form handle!";
+}
+
+const char *FormHandle::BorrowedFormException::what() const throw() {
+    return "Form is borrowed and cannot be owned!";
+}
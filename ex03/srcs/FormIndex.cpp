@@ -0,0 +1,140 @@
+#include "FormIndex.hpp"
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+
+// Range helpers
+FormIndex::const_iterator FormIndex::Range::begin() const {
+    return first;
+}
+
+FormIndex::const_iterator FormIndex::Range::end() const {
+    return last;
+}
+
+size_t FormIndex::Range::size() const {
+    return last - first;
+}
+
+bool FormIndex::Range::empty() const {
+    return first == last;
+}
+
+// Default constructor
+FormIndex::FormIndex()
+    : sign_prefix(LOWEST_GRADE + 2, 0), execute_prefix(LOWEST_GRADE + 2, 0) {
+}
+
+// Parameterized constructor
+FormIndex::FormIndex(const std::vector<AForm *> &forms)
+    : sign_prefix(LOWEST_GRADE + 2, 0), execute_prefix(LOWEST_GRADE + 2, 0) {
+    rebuild(forms);
+}
+
+// Copy constructor
+FormIndex::FormIndex(const FormIndex &src)
+    : unsigned_forms(src.unsigned_forms), signed_forms(src.signed_forms),
+      sign_prefix(src.sign_prefix), execute_prefix(src.execute_prefix) {
+}
+
+// Assignment operator
+FormIndex &FormIndex::operator=(const FormIndex &src) {
+    if (this == &src)
+        return *this;
+
+    this->unsigned_forms = src.unsigned_forms;
+    this->signed_forms = src.signed_forms;
+    this->sign_prefix = src.sign_prefix;
+    this->execute_prefix = src.execute_prefix;
+    return *this;
+}
+
+// Destructor
+FormIndex::~FormIndex() {
+}
+
+// Getters
+size_t FormIndex::getUnsignedCount() const {
+    return unsigned_forms.size();
+}
+
+size_t FormIndex::getSignedCount() const {
+    return signed_forms.size();
+}
+
+// Private helpers
+
+// Counting sort by required grade, 150 first. prefix[g] ends up as the
+// number of forms requiring grade g or a more lenient one.
+void FormIndex::bucket(const std::vector<AForm *> &forms, bool by_sign_grade,
+                       std::vector<AForm *> &sorted, std::vector<size_t> &prefix) {
+    std::vector<size_t> counts(LOWEST_GRADE + 2, 0);
+
+    for (size_t i = 0; i < forms.size(); i++)
+        counts[by_sign_grade ? forms[i]->getGradeToSign() : forms[i]->getGradeToExecute()]++;
+
+    prefix.assign(LOWEST_GRADE + 2, 0);
+    for (int grade = LOWEST_GRADE; grade >= 1; grade--)
+        prefix[grade] = prefix[grade + 1] + counts[grade];
+
+    // Each grade's bucket starts where the more lenient grades end
+    std::vector<size_t> next(LOWEST_GRADE + 2, 0);
+    for (int grade = 1; grade <= LOWEST_GRADE; grade++)
+        next[grade] = prefix[grade + 1];
+    sorted.resize(forms.size());
+    for (size_t i = 0; i < forms.size(); i++) {
+        int grade = by_sign_grade ? forms[i]->getGradeToSign() : forms[i]->getGradeToExecute();
+        sorted[next[grade]++] = forms[i];
+    }
+}
+
+FormIndex::Range FormIndex::prefixRange(const std::vector<AForm *> &forms,
+                                        const std::vector<size_t> &prefix, int grade) {
+    if (grade < 1)
+        throw Bureaucrat::GradeTooHighException();
+    if (grade > LOWEST_GRADE)
+        throw Bureaucrat::GradeTooLowException();
+
+    Range range;
+    range.first = forms.begin();
+    range.last = forms.begin() + prefix[grade];
+    return range;
+}
+
+// Member functions
+void FormIndex::rebuild(const std::vector<AForm *> &forms) {
+    std::vector<AForm *> pending_signature;
+    std::vector<AForm *> pending_execution;
+
+    for (size_t i = 0; i < forms.size(); i++) {
+        if (forms[i]->getIsSigned())
+            pending_execution.push_back(forms[i]);
+        else
+            pending_signature.push_back(forms[i]);
+    }
+    bucket(pending_signature, true, unsigned_forms, sign_prefix);
+    bucket(pending_execution, false, signed_forms, execute_prefix);
+}
+
+FormIndex::Range FormIndex::signableBy(int grade) const {
+    return prefixRange(unsigned_forms, sign_prefix, grade);
+}
+
+FormIndex::Range FormIndex::signableBy(const Bureaucrat &bureaucrat) const {
+    return signableBy(bureaucrat.getGrade());
+}
+
+FormIndex::Range FormIndex::executableBy(int grade) const {
+    return prefixRange(signed_forms, execute_prefix, grade);
+}
+
+FormIndex::Range FormIndex::executableBy(const Bureaucrat &bureaucrat) const {
+    return executableBy(bureaucrat.getGrade());
+}
+
+// Insertion operator overload
+std::ostream &operator<<(std::ostream &out, const FormIndex::Range &src) {
+    out << src.size() << " forms:";
+    for (FormIndex::const_iterator it = src.begin(); it != src.end(); ++it)
+        out << " " << (*it)->getName() << "(" << (*it)->getTarget() << ")";
+    return out;
+}
@@ -0,0 +1,96 @@
+#include "FormProtocol.hpp"
+#include "Bureaucrat.hpp"
+
+// Encoding
+void FormProtocol::encode(std::string &out, unsigned char opcode, unsigned char status,
+                          const std::string &payload) {
+    size_t length = payload.size() > MAX_PAYLOAD ? MAX_PAYLOAD : payload.size();
+
+    out += static_cast<char>(opcode);
+    out += static_cast<char>(status);
+    out += static_cast<char>((length >> 8) & 0xFF);
+    out += static_cast<char>(length & 0xFF);
+    out.append(payload, 0, length);
+}
+
+void FormProtocol::appendId(std::string &out, unsigned int id) {
+    out += static_cast<char>((id >> 24) & 0xFF);
+    out += static_cast<char>((id >> 16) & 0xFF);
+    out += static_cast<char>((id >> 8) & 0xFF);
+    out += static_cast<char>(id & 0xFF);
+}
+
+unsigned int FormProtocol::readId(const std::string &payload) {
+    unsigned int id = 0;
+
+    for (size_t i = 0; i < 4 && i < payload.size(); i++)
+        id = (id << 8) | static_cast<unsigned char>(payload[i]);
+    return id;
+}
+
+void FormProtocol::appendGrade(std::string &out, int grade) {
+    appendId(out, static_cast<unsigned int>(grade));
+}
+
+int FormProtocol::readGrade(const std::string &payload) {
+    if (payload.size() != 8)
+        throw FormProtocol::BadFrameException();
+
+    int grade = static_cast<int>(readId(payload.substr(4)));
+    if (grade < 1)
+        throw Bureaucrat::GradeTooHighException();
+    if (grade > 150)
+        throw Bureaucrat::GradeTooLowException();
+    return grade;
+}
+
+// Decoding
+bool FormProtocol::decode(const std::string &in, size_t &offset, Frame &frame) {
+    if (in.size() - offset < HEADER_SIZE)
+        return false;
+
+    size_t length = (static_cast<unsigned char>(in[offset + 2]) << 8)
+                    | static_cast<unsigned char>(in[offset + 3]);
+    if (in.size() - offset - HEADER_SIZE < length)
+        return false;
+
+    frame.opcode = static_cast<unsigned char>(in[offset]);
+    frame.status = static_cast<unsigned char>(in[offset + 1]);
+    frame.payload.assign(in, offset + HEADER_SIZE, length);
+    offset += HEADER_SIZE + length;
+    return true;
+}
+
+// Request builders
+void FormProtocol::makeRequest(std::string &out, const std::string &formName,
+                               const std::string &target) {
+    std::string payload = formName;
+    payload += '\0';
+    payload += target;
+    encode(out, MAKE, OK, payload);
+}
+
+void FormProtocol::signRequest(std::string &out, unsigned int id, int grade) {
+    std::string payload;
+    appendId(payload, id);
+    appendGrade(payload, grade);
+    encode(out, SIGN, OK, payload);
+}
+
+void FormProtocol::executeRequest(std::string &out, unsigned int id, int grade) {
+    std::string payload;
+    appendId(payload, id);
+    appendGrade(payload, grade);
+    encode(out, EXECUTE, OK, payload);
+}
+
+void FormProtocol::releaseRequest(std::string &out, unsigned int id) {
+    std::string payload;
+    appendId(payload, id);
+    encode(out, RELEASE, OK, payload);
+}
+
+// Exception implementation
+const char *FormProtocol::BadFrameException::what() const throw() {
+    return "Malformed frame payload!";
+}
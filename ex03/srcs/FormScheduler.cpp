@@ -0,0 +1,148 @@
+#include "FormScheduler.hpp"
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+#include <ctime>
+
+// Earliest deadline first, then higher priority, then the form with the
+// stricter execution grade (pardons before shrubberies), then FIFO
+bool FormScheduler::RunsAfter::operator()(const Entry &a, const Entry &b) const {
+    if (a.deadline != b.deadline) {
+        if (a.deadline == NO_DEADLINE)
+            return true;
+        if (b.deadline == NO_DEADLINE)
+            return false;
+        return a.deadline > b.deadline;
+    }
+    if (a.priority != b.priority)
+        return a.priority < b.priority;
+    if (a.form->getGradeToExecute() != b.form->getGradeToExecute())
+        return a.form->getGradeToExecute() > b.form->getGradeToExecute();
+    return a.sequence > b.sequence;
+}
+
+// Default constructor
+FormScheduler::FormScheduler() : next_sequence(0), executed(0), deadline_misses(0) {
+    pthread_mutex_init(&lock, NULL);
+}
+
+// Copy constructor
+FormScheduler::FormScheduler(const FormScheduler &src) {
+    pthread_mutex_init(&lock, NULL);
+    pthread_mutex_lock(&src.lock);
+    pending = src.pending;
+    next_sequence = src.next_sequence;
+    executed = src.executed;
+    deadline_misses = src.deadline_misses;
+    pthread_mutex_unlock(&src.lock);
+}
+
+// Assignment operator
+FormScheduler &FormScheduler::operator=(const FormScheduler &src) {
+    if (this == &src)
+        return *this;
+
+    FormScheduler copy(src);
+    pthread_mutex_lock(&lock);
+    this->pending = copy.pending;
+    this->next_sequence = copy.next_sequence;
+    this->executed = copy.executed;
+    this->deadline_misses = copy.deadline_misses;
+    pthread_mutex_unlock(&lock);
+    return *this;
+}
+
+// Destructor
+FormScheduler::~FormScheduler() {
+    pthread_mutex_destroy(&lock);
+}
+
+// Getters
+size_t FormScheduler::getPendingCount() const {
+    pthread_mutex_lock(&lock);
+    size_t count = pending.size();
+    pthread_mutex_unlock(&lock);
+    return count;
+}
+
+unsigned long FormScheduler::getExecutedCount() const {
+    pthread_mutex_lock(&lock);
+    unsigned long count = executed;
+    pthread_mutex_unlock(&lock);
+    return count;
+}
+
+unsigned long FormScheduler::getDeadlineMisses() const {
+    pthread_mutex_lock(&lock);
+    unsigned long count = deadline_misses;
+    pthread_mutex_unlock(&lock);
+    return count;
+}
+
+// Monotonic, so deadlines are not moved by wall-clock adjustments
+FormScheduler::Deadline FormScheduler::now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<Deadline>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+FormScheduler::Deadline FormScheduler::fromNow(long long microseconds) {
+    return now() + microseconds;
+}
+
+// Queue a form - it must outlive the scheduler or be run before it is freed
+void FormScheduler::schedule(const AForm &form, Deadline deadline, int priority) {
+    Entry entry;
+    entry.form = &form;
+    entry.deadline = deadline;
+    entry.priority = priority;
+
+    pthread_mutex_lock(&lock);
+    entry.sequence = next_sequence++;
+    pending.push(entry);
+    pthread_mutex_unlock(&lock);
+}
+
+// Pop the next form to run, if any
+bool FormScheduler::takeNext(Entry &entry) {
+    pthread_mutex_lock(&lock);
+    bool found = !pending.empty();
+    if (found) {
+        entry = pending.top();
+        pending.pop();
+    }
+    pthread_mutex_unlock(&lock);
+    return found;
+}
+
+// Execute up to max_forms forms in scheduling order. The lock is not held
+// while a form executes, so other threads keep scheduling and running;
+// a form counts as a miss when it finishes after its deadline.
+size_t FormScheduler::run(const Bureaucrat &executor, size_t max_forms) {
+    size_t done = 0;
+    Entry entry;
+
+    while (done < max_forms && takeNext(entry)) {
+        executor.executeForm(*entry.form);
+        bool missed = entry.deadline != NO_DEADLINE && now() > entry.deadline;
+        pthread_mutex_lock(&lock);
+        if (missed)
+            deadline_misses++;
+        executed++;
+        pthread_mutex_unlock(&lock);
+        done++;
+    }
+    return done;
+}
+
+// Run until the queue is empty, including forms scheduled meanwhile
+size_t FormScheduler::runAll(const Bureaucrat &executor) {
+    return run(executor, static_cast<size_t>(-1));
+}
+
+// Insertion operator overload
+std::ostream &operator<<(std::ostream &out, const FormScheduler &src) {
+    out << "FormScheduler pending: " << src.getPendingCount()
+        << ", executed: " << src.getExecutedCount()
+        << ", deadline misses: " << src.getDeadlineMisses();
+    return out;
+}
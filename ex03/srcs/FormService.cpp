@@ -0,0 +1,268 @@
+#include "FormService.hpp"
+#include "Bureaucrat.hpp"
+#include <cstring>
+#include <cerrno>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Constructor - the socket is created by open()
+FormService::FormService(const std::string &_socket_path)
+    : socket_path(_socket_path), listen_fd(-1), next_id(1), handled(0), running(0) {
+}
+
+// Destructor
+FormService::~FormService() {
+    for (std::map<int, Connection>::iterator it = connections.begin(); it != connections.end(); ++it) {
+        close(it->first);
+        releaseForms(it->second);
+    }
+    if (listen_fd >= 0) {
+        close(listen_fd);
+        unlink(socket_path.c_str());
+    }
+}
+
+// Getters
+unsigned long FormService::getHandledCount() const {
+    return handled;
+}
+
+size_t FormService::getFormCount() const {
+    size_t count = 0;
+
+    for (std::map<int, Connection>::const_iterator it = connections.begin(); it != connections.end(); ++it)
+        count += it->second.forms.size();
+    return count;
+}
+
+// Bind and listen on the Unix socket
+void FormService::open() {
+    struct sockaddr_un address;
+
+    if (socket_path.size() >= sizeof(address.sun_path))
+        throw FormService::SocketException();
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socket_path.c_str());
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+        throw FormService::SocketException();
+    unlink(socket_path.c_str());
+    if (bind(listen_fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) < 0
+        || listen(listen_fd, SOMAXCONN) < 0
+        || fcntl(listen_fd, F_SETFL, O_NONBLOCK) < 0) {
+        close(listen_fd);
+        listen_fd = -1;
+        throw FormService::SocketException();
+    }
+}
+
+// Event loop - returns once stop() has been called
+void FormService::run() {
+    if (listen_fd < 0)
+        open();
+    running = 1;
+
+    while (running) {
+        std::vector<struct pollfd> fds;
+        struct pollfd listener;
+        listener.fd = listen_fd;
+        listener.events = POLLIN;
+        listener.revents = 0;
+        fds.push_back(listener);
+        for (std::map<int, Connection>::iterator it = connections.begin(); it != connections.end(); ++it) {
+            struct pollfd client;
+            client.fd = it->first;
+            client.events = (it->second.closing ? 0 : POLLIN) | (it->second.out.empty() ? 0 : POLLOUT);
+            client.revents = 0;
+            fds.push_back(client);
+        }
+
+        if (poll(&fds[0], fds.size(), 200) < 0) {
+            if (errno == EINTR)
+                continue;
+            throw FormService::SocketException();
+        }
+        if (fds[0].revents & POLLIN)
+            acceptClients();
+        for (size_t i = 1; i < fds.size(); i++) {
+            if (!fds[i].revents)
+                continue;
+            Connection &connection = connections[fds[i].fd];
+            bool open_connection = true;
+            if (!connection.closing && (fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+                open_connection = readClient(connection);
+            else if (fds[i].revents & (POLLHUP | POLLERR))
+                open_connection = false;
+            if (open_connection && !connection.out.empty())
+                open_connection = writeClient(connection);
+            if (open_connection && connection.closing && connection.out.empty())
+                open_connection = false;
+            if (!open_connection)
+                closeClient(fds[i].fd);
+        }
+    }
+}
+
+void FormService::stop() {
+    running = 0;
+}
+
+// Private helpers
+void FormService::acceptClients() {
+    while (true) {
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0)
+            return;
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        Connection connection;
+        connection.fd = fd;
+        connection.closing = false;
+        connections[fd] = connection;
+    }
+}
+
+// Read what is available, up to MAX_BUFFERED, then answer every complete
+// frame as a batch; poll() calls back for the rest. Returns false when the
+// connection must be dropped: a read error, or a client that overflows
+// either buffer (unread responses count too).
+bool FormService::readClient(Connection &connection) {
+    char buffer[65536];
+    bool open_connection = true;
+
+    while (connection.in.size() < MAX_BUFFERED) {
+        ssize_t count = read(connection.fd, buffer, sizeof(buffer));
+        if (count > 0) {
+            connection.in.append(buffer, count);
+            continue;
+        }
+        if (count == 0)
+            connection.closing = true;
+        else if (errno == EINTR)
+            continue;
+        else if (errno != EAGAIN && errno != EWOULDBLOCK)
+            open_connection = false;
+        break;
+    }
+
+    size_t offset = 0;
+    FormProtocol::Frame frame;
+    while (FormProtocol::decode(connection.in, offset, frame))
+        handleFrame(frame, connection);
+    connection.in.erase(0, offset);
+    if (connection.in.size() > FormProtocol::HEADER_SIZE + FormProtocol::MAX_PAYLOAD
+        || connection.out.size() > MAX_BUFFERED)
+        return false;
+    return open_connection;
+}
+
+bool FormService::writeClient(Connection &connection) {
+    while (!connection.out.empty()) {
+        ssize_t count = write(connection.fd, connection.out.data(), connection.out.size());
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        connection.out.erase(0, count);
+    }
+    return true;
+}
+
+// Forms a client never released go away with its connection
+void FormService::closeClient(int fd) {
+    close(fd);
+    releaseForms(connections[fd]);
+    connections.erase(fd);
+}
+
+void FormService::releaseForms(Connection &connection) {
+    for (std::map<unsigned int, AForm *>::iterator it = connection.forms.begin();
+         it != connection.forms.end(); ++it)
+        delete it->second;
+    connection.forms.clear();
+}
+
+// Clients only see the forms they made themselves
+AForm *FormService::findForm(Connection &connection, const std::string &payload) {
+    if (payload.size() < 4)
+        throw FormService::BadRequestException();
+    std::map<unsigned int, AForm *>::iterator it = connection.forms.find(FormProtocol::readId(payload));
+    if (it == connection.forms.end())
+        throw FormService::UnknownFormException();
+    return it->second;
+}
+
+bool FormService::isValidTarget(const std::string &target) {
+    return !target.empty() && target[0] != '.'
+        && target.find('/') == std::string::npos
+        && target.find('\0') == std::string::npos;
+}
+
+// Run one request against the Intern/Bureaucrat/AForm core
+void FormService::handleFrame(const FormProtocol::Frame &frame, Connection &connection) {
+    std::string &out = connection.out;
+    std::string payload;
+
+    handled++;
+    try {
+        switch (frame.opcode) {
+        case FormProtocol::MAKE: {
+            size_t separator = frame.payload.find('\0');
+            if (separator == std::string::npos)
+                throw FormService::BadRequestException();
+            std::string target = frame.payload.substr(separator + 1);
+            if (!isValidTarget(target))
+                throw FormService::BadTargetException();
+            AForm *form = intern.makeForm(frame.payload.substr(0, separator), target);
+            connection.forms[next_id] = form;
+            FormProtocol::appendId(payload, next_id++);
+            break;
+        }
+        case FormProtocol::SIGN:
+        case FormProtocol::EXECUTE: {
+            AForm *form = findForm(connection, frame.payload);
+            Bureaucrat bureaucrat("Client", FormProtocol::readGrade(frame.payload));
+            if (frame.opcode == FormProtocol::SIGN)
+                form->beSigned(bureaucrat);
+            else
+                form->execute(bureaucrat);
+            break;
+        }
+        case FormProtocol::RELEASE: {
+            AForm *form = findForm(connection, frame.payload);
+            connection.forms.erase(FormProtocol::readId(frame.payload));
+            delete form;
+            break;
+        }
+        default:
+            throw FormService::BadRequestException();
+        }
+    }
+    catch (std::exception &e) {
+        FormProtocol::encode(out, frame.opcode, FormProtocol::ERROR, e.what());
+        return;
+    }
+    FormProtocol::encode(out, frame.opcode, FormProtocol::OK, payload);
+}
+
+// Exception implementations
+const char *FormService::SocketException::what() const throw() {
+    return "Form service socket error!";
+}
+
+const char *FormService::UnknownFormException::what() const throw() {
+    return "Unknown form id!";
+}
+
+const char *FormService::BadRequestException::what() const throw() {
+    return "Malformed request!";
+}
+
+const char *FormService::BadTargetException::what() const throw() {
+    return "Target must be a plain name!";
+}
@@ -0,0 +1,207 @@
+#include "FormTypeRegistry.hpp"
+#include "EpochReclaimer.hpp"
+#include <fstream>
+#include <sstream>
+
+// Snapshot lookup by Intern name - returns -1 for unknown names
+int FormTypeRegistry::Snapshot::findType(const std::string &name) const {
+    for (int i = 0; i < Intern::FORM_TYPE_COUNT; i++) {
+        if (types[i].name == name)
+            return i;
+    }
+    return -1;
+}
+
+// Constructor
+FormTypeRegistry::FormTypeRegistry(EpochReclaimer &_reclaimer)
+    : reclaimer(_reclaimer), current(defaults()), versions(0) {
+}
+
+// Destructor
+FormTypeRegistry::~FormTypeRegistry() {
+    delete current;
+}
+
+// Readers - the copy stays valid after the guard is gone
+FormTypeRegistry::Snapshot FormTypeRegistry::getSnapshot(int slot) const {
+    EpochReclaimer::Guard guard(reclaimer, slot);
+    return currentSnapshot();
+}
+
+unsigned long FormTypeRegistry::getVersion(int slot) const {
+    EpochReclaimer::Guard guard(reclaimer, slot);
+    return currentSnapshot().version;
+}
+
+// Create a form with the grades of the current snapshot
+AForm *FormTypeRegistry::makeForm(int slot, const std::string &name, const std::string &target) const {
+    EpochReclaimer::Guard guard(reclaimer, slot);
+    const Snapshot &snapshot = currentSnapshot();
+    int typeId = findType(snapshot, name);
+    const FormType &type = snapshot.types[typeId];
+
+    return Intern::makeForm(typeId, target, type.grade_to_sign, type.grade_to_execute);
+}
+
+FormDescriptor FormTypeRegistry::makeFormDescriptor(int slot, const std::string &name,
+                                                    const std::string &target) const {
+    EpochReclaimer::Guard guard(reclaimer, slot);
+    const Snapshot &snapshot = currentSnapshot();
+    int typeId = findType(snapshot, name);
+    const FormType &type = snapshot.types[typeId];
+
+    FormDescriptor descriptor = FormDescriptor::make(typeId, target, type.grade_to_sign,
+                                                     type.grade_to_execute);
+    std::cout << "Intern creates " << type.name << std::endl;
+    return descriptor;
+}
+
+// Permissions for the grades of the current snapshot
+PermissionMatrix FormTypeRegistry::makePermissionMatrix(int slot) const {
+    EpochReclaimer::Guard guard(reclaimer, slot);
+    const Snapshot &snapshot = currentSnapshot();
+    PermissionMatrix matrix;
+
+    for (int type = 0; type < Intern::FORM_TYPE_COUNT; type++)
+        matrix.registerType(type, snapshot.types[type].grade_to_sign,
+                            snapshot.types[type].grade_to_execute);
+    return matrix;
+}
+
+// Private helpers - the caller holds an epoch guard
+const FormTypeRegistry::Snapshot &FormTypeRegistry::currentSnapshot() const {
+    Snapshot *snapshot = current;
+    __sync_synchronize();
+    return *snapshot;
+}
+
+int FormTypeRegistry::findType(const Snapshot &snapshot, const std::string &name) {
+    int typeId = snapshot.findType(name);
+
+    if (typeId < 0) {
+        std::cout << "Intern cannot create form: \"" << name
+                  << "\" does not exist" << std::endl;
+        throw Intern::FormNotFoundException();
+    }
+    return typeId;
+}
+
+FormTypeRegistry::Snapshot *FormTypeRegistry::defaults() {
+    Snapshot *snapshot = new Snapshot;
+
+    snapshot->version = 0;
+    for (int i = 0; i < Intern::FORM_TYPE_COUNT; i++) {
+        snapshot->types[i].name = Intern::getFormTypeName(i);
+        snapshot->types[i].grade_to_sign = Intern::getGradeToSign(i);
+        snapshot->types[i].grade_to_execute = Intern::getGradeToExecute(i);
+    }
+    return snapshot;
+}
+
+static bool isValidGrade(int grade) {
+    return grade >= 1 && grade <= 150;
+}
+
+// Lines are checked one by one; names are checked once the whole file
+// is read, so entries may rename types in any order
+FormTypeRegistry::Snapshot *FormTypeRegistry::parse(std::istream &in) {
+    Snapshot *snapshot = defaults();
+    bool configured[Intern::FORM_TYPE_COUNT] = {};
+    std::string line;
+    int line_number = 0;
+
+    while (std::getline(in, line)) {
+        line_number++;
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+
+        std::istringstream fields(line);
+        std::string class_name;
+        int sign;
+        int execute;
+        if (!(fields >> class_name))
+            continue;
+
+        int typeId = -1;
+        for (int i = 0; i < Intern::FORM_TYPE_COUNT; i++) {
+            if (class_name == Intern::getFormClassName(i))
+                typeId = i;
+        }
+
+        std::string name;
+        bool valid = typeId >= 0 && !configured[typeId] && (fields >> sign >> execute)
+            && isValidGrade(sign) && isValidGrade(execute);
+        if (valid) {
+            configured[typeId] = true;
+            std::getline(fields >> std::ws, name);
+            std::string::size_type end = name.find_last_not_of(" \t\r");
+            name.erase(end == std::string::npos ? 0 : end + 1);
+        }
+        if (!valid) {
+            std::cout << "Form type configuration, line " << line_number
+                      << ": invalid entry" << std::endl;
+            delete snapshot;
+            throw FormTypeRegistry::InvalidConfigException();
+        }
+
+        FormType &type = snapshot->types[typeId];
+        type.grade_to_sign = sign;
+        type.grade_to_execute = execute;
+        if (!name.empty())
+            type.name = name;
+    }
+
+    for (int i = 0; i < Intern::FORM_TYPE_COUNT; i++) {
+        if (snapshot->findType(snapshot->types[i].name) != i) {
+            std::cout << "Form type configuration: \"" << snapshot->types[i].name
+                      << "\" names two form types" << std::endl;
+            delete snapshot;
+            throw FormTypeRegistry::InvalidConfigException();
+        }
+    }
+    return snapshot;
+}
+
+void FormTypeRegistry::deleteSnapshot(void *snapshot) {
+    delete static_cast<Snapshot *>(snapshot);
+}
+
+// Swap in the new snapshot; the old one is freed once readers moved on
+void FormTypeRegistry::publish(Snapshot *snapshot) {
+    snapshot->version = __sync_add_and_fetch(&versions, 1);
+    __sync_synchronize();
+    Snapshot *previous = __sync_lock_test_and_set(&current, snapshot);
+    reclaimer.retire(previous, &FormTypeRegistry::deleteSnapshot);
+}
+
+// Writers
+void FormTypeRegistry::load(std::istream &in) {
+    publish(parse(in));
+}
+
+void FormTypeRegistry::load(const std::string &path) {
+    std::ifstream file(path.c_str());
+
+    if (!file.is_open())
+        throw FormTypeRegistry::ConfigFileException();
+    load(file);
+}
+
+// Exception implementations
+const char *FormTypeRegistry::InvalidConfigException::what() const throw() {
+    return "Invalid form type configuration!";
+}
+
+const char *FormTypeRegistry::ConfigFileException::what() const throw() {
+    return "Cannot open form type configuration!";
+}
+
+// Insertion operator overload
+std::ostream &operator<<(std::ostream &out, const FormTypeRegistry::Snapshot &src) {
+    out << "Form types, version " << src.version;
+    for (int i = 0; i < Intern::FORM_TYPE_COUNT; i++)
+        out << "\n  " << src.types[i].name << ": sign " << src.types[i].grade_to_sign
+            << ", execute " << src.types[i].grade_to_execute;
+    return out;
+}
@@ -1,5 +1,8 @@
 #include "Intern.hpp"
+#include "Trace.hpp"
 #include <iostream>
+#include <map>
+#include <new>
 
 // Default constructor
 Intern::Intern() {
@@ -36,33 +39,224 @@ AForm* Intern::createPresidentialForm(const std::string &target) {
     return new PresidentialPardonForm(target);
 }
 
+AForm* Intern::createShrubberyFormWithGrades(const std::string &target, int gradeToSign, int gradeToExecute) {
+    return new ShrubberyCreationForm(target, gradeToSign, gradeToExecute);
+}
+
+AForm* Intern::createRobotomyFormWithGrades(const std::string &target, int gradeToSign, int gradeToExecute) {
+    return new RobotomyRequestForm(target, gradeToSign, gradeToExecute);
+}
+
+AForm* Intern::createPresidentialFormWithGrades(const std::string &target, int gradeToSign, int gradeToExecute) {
+    return new PresidentialPardonForm(target, gradeToSign, gradeToExecute);
+}
+
+// Placement creation methods
+AForm* Intern::placeShrubberyForm(void *where, const std::string &target) {
+    return new (where) ShrubberyCreationForm(target);
+}
+
+AForm* Intern::placeRobotomyForm(void *where, const std::string &target) {
+    return new (where) RobotomyRequestForm(target);
+}
+
+AForm* Intern::placePresidentialForm(void *where, const std::string &target) {
+    return new (where) PresidentialPardonForm(target);
+}
+
+// Table of form types, indexed by FormTypeId
+// This is the elegant way to avoid if/else/elseif chains
+const Intern::FormType Intern::form_types[] = {
+    {"shrubbery creation", "ShrubberyCreationForm",
+        ShrubberyCreationForm::GRADE_TO_SIGN, ShrubberyCreationForm::GRADE_TO_EXECUTE, true,
+        &Intern::createShrubberyForm, &Intern::createShrubberyFormWithGrades,
+        sizeof(ShrubberyCreationForm), __alignof__(ShrubberyCreationForm), &Intern::placeShrubberyForm},
+    {"robotomy request", "RobotomyRequestForm",
+        RobotomyRequestForm::GRADE_TO_SIGN, RobotomyRequestForm::GRADE_TO_EXECUTE, false,
+        &Intern::createRobotomyForm, &Intern::createRobotomyFormWithGrades,
+        sizeof(RobotomyRequestForm), __alignof__(RobotomyRequestForm), &Intern::placeRobotomyForm},
+    {"presidential pardon", "PresidentialPardonForm",
+        PresidentialPardonForm::GRADE_TO_SIGN, PresidentialPardonForm::GRADE_TO_EXECUTE, true,
+        &Intern::createPresidentialForm, &Intern::createPresidentialFormWithGrades,
+        sizeof(PresidentialPardonForm), __alignof__(PresidentialPardonForm), &Intern::placePresidentialForm}
+};
+
 // Main factory method - elegant implementation without if/else chain
 AForm* Intern::makeForm(const std::string &formName, const std::string &target) {
-    // Array of form types with their names and creation functions
-    // This is the elegant way to avoid if/else/elseif chains
-    FormType formTypes[] = {
-        {"shrubbery creation", &Intern::createShrubberyForm},
-        {"robotomy request", &Intern::createRobotomyForm},
-        {"presidential pardon", &Intern::createPresidentialForm}
-    };
+    int typeId = getFormTypeId(formName);
+    
+    if (typeId < 0) {
+        // Form not found
+        std::cout << "Intern cannot create form: \"" << formName 
+                  << "\" does not exist" << std::endl;
+        throw Intern::FormNotFoundException();
+    }
+    return makeForm(typeId, target);
+}
+
+// Factory method for an already resolved form type
+AForm* Intern::makeForm(int typeId, const std::string &target) {
+    if (typeId < 0 || typeId >= FORM_TYPE_COUNT)
+        throw Intern::FormNotFoundException();
+    
+    // Call the appropriate creation function using member function pointer
+    AForm *form = (this->*(form_types[typeId].creator))(target);
+    FORM_TRACE3(make_form, form_types[typeId].class_name, typeId, target.c_str());
+    std::cout << "Intern creates " << form_types[typeId].name << std::endl;
+    return form;
+}
+
+// Factory method for a form type with its grades overridden, e.g. when
+// restoring a saved form or applying a form type configuration
+AForm* Intern::makeForm(int typeId, const std::string &target, int gradeToSign, int gradeToExecute) {
+    if (typeId < 0 || typeId >= FORM_TYPE_COUNT)
+        throw Intern::FormNotFoundException();
+    
+    AForm *form = form_types[typeId].creator_with_grades(target, gradeToSign, gradeToExecute);
+    FORM_TRACE3(make_form, form_types[typeId].class_name, typeId, target.c_str());
+    std::cout << "Intern creates " << form_types[typeId].name << std::endl;
+    return form;
+}
+
+// Same as makeForm, but the form is owned by the returned handle
+FormHandle Intern::makeFormHandle(const std::string &formName, const std::string &target) {
+    return FormHandle(makeForm(formName, target));
+}
+
+// Lightweight alternative: nothing is allocated until the form executes
+FormDescriptor Intern::makeFormDescriptor(const std::string &formName, const std::string &target) {
+    int typeId = getFormTypeId(formName);
     
-    // Search for matching form type
-    for (int i = 0; i < 3; i++) {
-        if (formTypes[i].name == formName) {
-            // Call the appropriate creation function using member function pointer
-            AForm *form = (this->*(formTypes[i].creator))(target);
-            std::cout << "Intern creates " << formName << std::endl;
-            return form;
+    if (typeId < 0) {
+        std::cout << "Intern cannot create form: \"" << formName 
+                  << "\" does not exist" << std::endl;
+        throw Intern::FormNotFoundException();
+    }
+    FormDescriptor descriptor = FormDescriptor::make(typeId, target);
+    std::cout << "Intern creates " << form_types[typeId].name << std::endl;
+    return descriptor;
+}
+
+// Offset rounded up to the alignment of the form type placed there
+static size_t alignOffset(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+// Create many forms at once: one allocation holds the pointer array (in
+// input order) followed by the forms grouped by type. Each distinct name
+// is resolved only once. Nothing is created if any name is unknown.
+void Intern::makeForms(const std::vector<std::string> &formNames, const std::vector<std::string> &targets,
+                       FormBatch &batch) {
+    if (formNames.size() != targets.size())
+        throw Intern::BatchSizeMismatchException();
+    
+    const size_t count = formNames.size();
+    std::vector<int> typeIds(count);
+    std::map<std::string, int> resolved;
+    size_t typeCounts[FORM_TYPE_COUNT] = {0};
+    
+    for (size_t i = 0; i < count; i++) {
+        std::map<std::string, int>::iterator it = resolved.find(formNames[i]);
+        if (it == resolved.end())
+            it = resolved.insert(std::make_pair(formNames[i], getFormTypeId(formNames[i]))).first;
+        if (it->second < 0) {
+            std::cout << "Intern cannot create form: \"" << formNames[i] 
+                      << "\" does not exist" << std::endl;
+            throw Intern::FormNotFoundException();
         }
+        typeIds[i] = it->second;
+        typeCounts[it->second]++;
     }
     
-    // Form not found
-    std::cout << "Intern cannot create form: \"" << formName 
-              << "\" does not exist" << std::endl;
-    throw Intern::FormNotFoundException();
+    // Pointer array first, then one group per form type. sizeof is a
+    // multiple of the type's alignment, so only group starts need padding;
+    // operator new aligns the buffer for any of the form types.
+    size_t next[FORM_TYPE_COUNT];
+    size_t total = count * sizeof(AForm *);
+    for (int type = 0; type < FORM_TYPE_COUNT; type++) {
+        next[type] = alignOffset(total, form_types[type].alignment);
+        total = next[type] + typeCounts[type] * form_types[type].size;
+    }
+    
+    batch.clear();
+    char *storage = static_cast<char *>(::operator new(total));
+    AForm **forms = reinterpret_cast<AForm **>(storage);
+    size_t created = 0;
+    try {
+        for (; created < count; created++) {
+            const FormType &type = form_types[typeIds[created]];
+            forms[created] = type.placer(storage + next[typeIds[created]], targets[created]);
+            FormHandle::markBorrowed(*forms[created]);
+            FORM_TRACE3(make_form, type.class_name, typeIds[created], targets[created].c_str());
+            next[typeIds[created]] += type.size;
+        }
+    }
+    catch (...) {
+        for (size_t i = 0; i < created; i++)
+            forms[i]->~AForm();
+        ::operator delete(storage);
+        throw;
+    }
+    batch.storage = storage;
+    batch.forms = forms;
+    batch.count = count;
+    std::cout << "Intern creates a batch of " << count << " forms" << std::endl;
 }
 
-// Exception implementation
+// Form type lookup by Intern name ("robotomy request")
+int Intern::getFormTypeId(const std::string &formName) {
+    for (int i = 0; i < FORM_TYPE_COUNT; i++) {
+        if (formName == form_types[i].name)
+            return i;
+    }
+    return -1;
+}
+
+// Form type lookup by the name the form reports ("RobotomyRequestForm")
+int Intern::getFormTypeId(const AForm &form) {
+    for (int i = 0; i < FORM_TYPE_COUNT; i++) {
+        if (form.getName() == form_types[i].class_name)
+            return i;
+    }
+    return -1;
+}
+
+const char *Intern::getFormTypeName(int typeId) {
+    if (typeId < 0 || typeId >= FORM_TYPE_COUNT)
+        throw Intern::FormNotFoundException();
+    return form_types[typeId].name;
+}
+
+const char *Intern::getFormClassName(int typeId) {
+    if (typeId < 0 || typeId >= FORM_TYPE_COUNT)
+        throw Intern::FormNotFoundException();
+    return form_types[typeId].class_name;
+}
+
+int Intern::getGradeToSign(int typeId) {
+    if (typeId < 0 || typeId >= FORM_TYPE_COUNT)
+        throw Intern::FormNotFoundException();
+    return form_types[typeId].grade_to_sign;
+}
+
+int Intern::getGradeToExecute(int typeId) {
+    if (typeId < 0 || typeId >= FORM_TYPE_COUNT)
+        throw Intern::FormNotFoundException();
+    return form_types[typeId].grade_to_execute;
+}
+
+// Robotomies succeed at random, so running one again is not redundant
+bool Intern::isDeterministic(int typeId) {
+    if (typeId < 0 || typeId >= FORM_TYPE_COUNT)
+        throw Intern::FormNotFoundException();
+    return form_types[typeId].deterministic;
+}
+
+// Exception implementations
 const char* Intern::FormNotFoundException::what() const throw() {
     return "Form type not found!";
 }
+
+const char* Intern::BatchSizeMismatchException::what() const throw() {
+    return "One target per form name is required!";
+}
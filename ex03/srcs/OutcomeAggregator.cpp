@@ -0,0 +1,238 @@
+#include "OutcomeAggregator.hpp"
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+#include <algorithm>
+#include <cstring>
+
+// Orders (target, count) pairs by descending count
+static bool byCountDescending(const std::pair<std::string, unsigned long> &a,
+                              const std::pair<std::string, unsigned long> &b) {
+    if (a.second != b.second)
+        return a.second > b.second;
+    return a.first < b.first;
+}
+
+// Default constructor
+OutcomeShard::OutcomeShard() {
+    reset();
+}
+
+// Copy constructor
+OutcomeShard::OutcomeShard(const OutcomeShard &src) {
+    reset();
+    merge(src);
+}
+
+// Assignment operator
+OutcomeShard &OutcomeShard::operator=(const OutcomeShard &src) {
+    if (this == &src)
+        return *this;
+
+    reset();
+    merge(src);
+    return *this;
+}
+
+// Destructor
+OutcomeShard::~OutcomeShard() {
+}
+
+// Record one sign or execute outcome
+void OutcomeShard::record(int typeId, Stage stage, int grade, bool accepted, TargetPool::Handle target) {
+    if (typeId >= 0 && typeId < Intern::FORM_TYPE_COUNT)
+        attempts[typeId][stage]++;
+    if (grade >= 1 && grade <= 150) {
+        int band = (grade - 1) / BAND_SIZE;
+        band_attempts[stage][band]++;
+        band_rejections[stage][band] += !accepted;
+    }
+    if (target >= targets.size())
+        targets.resize(TargetPool::getSize() > target ? TargetPool::getSize() : target + 1, 0);
+    targets[target]++;
+}
+
+void OutcomeShard::recordRobotomy(bool succeeded) {
+    robotomy_attempts++;
+    robotomy_successes += succeeded;
+}
+
+// Sign through the regular path and record the outcome
+bool OutcomeShard::sign(AForm &form, const Bureaucrat &signer) {
+    bool accepted = true;
+
+    try {
+        form.beSigned(signer);
+    }
+    catch (std::exception &) {
+        accepted = false;
+    }
+    record(Intern::getFormTypeId(form), SIGN, signer.getGrade(), accepted, form.getTargetHandle());
+    return accepted;
+}
+
+// Execute through the regular path and record the outcome
+bool OutcomeShard::execute(const AForm &form, const Bureaucrat &executor) {
+    int typeId = Intern::getFormTypeId(form);
+    bool accepted = true;
+    bool succeeded = false;
+
+    try {
+        succeeded = form.perform(executor);
+    }
+    catch (std::exception &) {
+        accepted = false;
+    }
+    record(typeId, EXECUTE, executor.getGrade(), accepted, form.getTargetHandle());
+    if (accepted && typeId == Intern::ROBOTOMY_REQUEST)
+        recordRobotomy(succeeded);
+    return accepted && succeeded;
+}
+
+void OutcomeShard::merge(const OutcomeShard &other) {
+    for (int type = 0; type < Intern::FORM_TYPE_COUNT; type++) {
+        for (int stage = 0; stage < STAGE_COUNT; stage++)
+            attempts[type][stage] += other.attempts[type][stage];
+    }
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        for (int band = 0; band < BAND_COUNT; band++) {
+            band_attempts[stage][band] += other.band_attempts[stage][band];
+            band_rejections[stage][band] += other.band_rejections[stage][band];
+        }
+    }
+    robotomy_attempts += other.robotomy_attempts;
+    robotomy_successes += other.robotomy_successes;
+    if (other.targets.size() > targets.size())
+        targets.resize(other.targets.size(), 0);
+    for (size_t i = 0; i < other.targets.size(); i++)
+        targets[i] += other.targets[i];
+}
+
+void OutcomeShard::reset() {
+    std::memset(attempts, 0, sizeof(attempts));
+    std::memset(band_attempts, 0, sizeof(band_attempts));
+    std::memset(band_rejections, 0, sizeof(band_rejections));
+    robotomy_attempts = 0;
+    robotomy_successes = 0;
+    targets.clear();
+}
+
+// Queries
+unsigned long OutcomeShard::getAttempts(int typeId, Stage stage) const {
+    if (typeId < 0 || typeId >= Intern::FORM_TYPE_COUNT)
+        throw Intern::FormNotFoundException();
+    return attempts[typeId][stage];
+}
+
+unsigned long OutcomeShard::getBandAttempts(Stage stage, int band) const {
+    if (band < 0 || band >= BAND_COUNT)
+        throw OutcomeShard::InvalidBandException();
+    return band_attempts[stage][band];
+}
+
+double OutcomeShard::getRejectionRate(Stage stage, int band) const {
+    if (getBandAttempts(stage, band) == 0)
+        return 0.0;
+    return static_cast<double>(band_rejections[stage][band]) / band_attempts[stage][band];
+}
+
+double OutcomeShard::getRobotomySuccessRatio() const {
+    if (robotomy_attempts == 0)
+        return 0.0;
+    return static_cast<double>(robotomy_successes) / robotomy_attempts;
+}
+
+void OutcomeShard::getTopTargets(size_t count,
+                                 std::vector<std::pair<std::string, unsigned long> > &out) const {
+    out.clear();
+    for (size_t i = 0; i < targets.size(); i++) {
+        if (targets[i])
+            out.push_back(std::make_pair(TargetPool::get(static_cast<TargetPool::Handle>(i)), targets[i]));
+    }
+    if (count < out.size()) {
+        std::partial_sort(out.begin(), out.begin() + count, out.end(), byCountDescending);
+        out.resize(count);
+    }
+    else
+        std::sort(out.begin(), out.end(), byCountDescending);
+}
+
+// Exception implementation
+const char *OutcomeShard::InvalidBandException::what() const throw() {
+    return "Grade band out of range!";
+}
+
+// Default constructor
+OutcomeAggregator::OutcomeAggregator() : shards(1) {
+}
+
+// Parameterized constructor - one shard per worker
+OutcomeAggregator::OutcomeAggregator(size_t shard_count) : shards(shard_count) {
+    if (shard_count == 0)
+        throw OutcomeAggregator::InvalidShardException();
+}
+
+// Copy constructor
+OutcomeAggregator::OutcomeAggregator(const OutcomeAggregator &src) : shards(src.shards) {
+}
+
+// Assignment operator
+OutcomeAggregator &OutcomeAggregator::operator=(const OutcomeAggregator &src) {
+    if (this == &src)
+        return *this;
+
+    this->shards = src.shards;
+    return *this;
+}
+
+// Destructor
+OutcomeAggregator::~OutcomeAggregator() {
+}
+
+size_t OutcomeAggregator::getShardCount() const {
+    return shards.size();
+}
+
+OutcomeShard &OutcomeAggregator::getShard(size_t index) {
+    if (index >= shards.size())
+        throw OutcomeAggregator::InvalidShardException();
+    return shards[index];
+}
+
+// Combine every shard into one summary
+OutcomeShard OutcomeAggregator::merge() const {
+    OutcomeShard summary;
+
+    for (size_t i = 0; i < shards.size(); i++)
+        summary.merge(shards[i]);
+    return summary;
+}
+
+void OutcomeAggregator::reset() {
+    for (size_t i = 0; i < shards.size(); i++)
+        shards[i].reset();
+}
+
+// Exception implementation
+const char *OutcomeAggregator::InvalidShardException::what() const throw() {
+    return "Invalid outcome shard!";
+}
+
+// Insertion operator overload
+std::ostream &operator<<(std::ostream &out, const OutcomeShard &src) {
+    for (int type = 0; type < Intern::FORM_TYPE_COUNT; type++) {
+        out << Intern::getFormTypeName(type)
+            << ": sign attempts " << src.getAttempts(type, OutcomeShard::SIGN)
+            << ", execute attempts " << src.getAttempts(type, OutcomeShard::EXECUTE) << std::endl;
+    }
+    for (int band = 0; band < OutcomeShard::BAND_COUNT; band++) {
+        if (src.getBandAttempts(OutcomeShard::SIGN, band) == 0
+            && src.getBandAttempts(OutcomeShard::EXECUTE, band) == 0)
+            continue;
+        out << "grades " << band * OutcomeShard::BAND_SIZE + 1
+            << "-" << (band + 1) * OutcomeShard::BAND_SIZE
+            << ": sign rejections " << src.getRejectionRate(OutcomeShard::SIGN, band)
+            << ", execute rejections " << src.getRejectionRate(OutcomeShard::EXECUTE, band) << std::endl;
+    }
+    out << "robotomy success ratio: " << src.getRobotomySuccessRatio();
+    return out;
+}
@@ -0,0 +1,144 @@
+#include "PackedRoster.hpp"
+#include "Bureaucrat.hpp"
+
+// Default constructor
+PackedRoster::PackedRoster() : histogram(LOWEST_GRADE + 1, 0) {
+}
+
+// Copy constructor
+PackedRoster::PackedRoster(const PackedRoster &src)
+    : names(src.names), grades(src.grades), histogram(src.histogram) {
+}
+
+// Assignment operator
+PackedRoster &PackedRoster::operator=(const PackedRoster &src) {
+    if (this == &src)
+        return *this;
+
+    this->names = src.names;
+    this->grades = src.grades;
+    this->histogram = src.histogram;
+    return *this;
+}
+
+// Destructor
+PackedRoster::~PackedRoster() {
+}
+
+// Getters
+size_t PackedRoster::getSize() const {
+    return grades.size();
+}
+
+const std::string &PackedRoster::getName(size_t index) const {
+    if (index >= names.size())
+        throw PackedRoster::IndexOutOfRangeException();
+    return names[index];
+}
+
+int PackedRoster::getGrade(size_t index) const {
+    if (index >= grades.size())
+        throw PackedRoster::IndexOutOfRangeException();
+    return grades[index];
+}
+
+size_t PackedRoster::countAtGrade(int grade) const {
+    if (grade < HIGHEST_GRADE)
+        throw Bureaucrat::GradeTooHighException();
+    if (grade > LOWEST_GRADE)
+        throw Bureaucrat::GradeTooLowException();
+    return histogram[grade];
+}
+
+// Number of bureaucrats at grade or better
+size_t PackedRoster::countAtOrAbove(int grade) const {
+    size_t count = 0;
+
+    if (grade > LOWEST_GRADE)
+        grade = LOWEST_GRADE;
+    for (int g = HIGHEST_GRADE; g <= grade; g++)
+        count += histogram[g];
+    return count;
+}
+
+// Member functions
+size_t PackedRoster::add(const std::string &name, int grade) {
+    if (grade < HIGHEST_GRADE)
+        throw Bureaucrat::GradeTooHighException();
+    if (grade > LOWEST_GRADE)
+        throw Bureaucrat::GradeTooLowException();
+    names.push_back(name);
+    grades.push_back(static_cast<unsigned char>(grade));
+    histogram[grade]++;
+    return grades.size() - 1;
+}
+
+size_t PackedRoster::add(const Bureaucrat &bureaucrat) {
+    return add(bureaucrat.getName(), bureaucrat.getGrade());
+}
+
+// Apply one delta per bureaucrat, positive deltas promote like
+// incrementGrade. Results outside 1-150 saturate at the bound and are
+// reported in errors instead of throwing. Returns the number of grades
+// that changed.
+size_t PackedRoster::applyDeltas(const std::vector<int> &deltas, std::vector<GradeError> &errors) {
+    if (deltas.size() != grades.size())
+        throw PackedRoster::SizeMismatchException();
+
+    const size_t count = grades.size();
+    std::vector<unsigned char> updated(count);
+    size_t saturated = 0;
+    size_t changed = 0;
+
+    // Branch-free clamp over the packed bytes, so the compiler can
+    // vectorize it. Deltas are clamped to +-150 first: larger ones
+    // saturate anyway, and the subtraction can no longer overflow.
+    for (size_t i = 0; i < count; i++) {
+        int delta = deltas[i];
+        delta = delta < -LOWEST_GRADE ? -LOWEST_GRADE : delta;
+        delta = delta > LOWEST_GRADE ? LOWEST_GRADE : delta;
+        int grade = grades[i] - delta;
+        int clamped = grade < HIGHEST_GRADE ? HIGHEST_GRADE : grade;
+        clamped = clamped > LOWEST_GRADE ? LOWEST_GRADE : clamped;
+        updated[i] = static_cast<unsigned char>(clamped);
+        saturated += clamped != grade;
+    }
+
+    errors.clear();
+    errors.reserve(saturated);
+    for (size_t i = 0; i < count; i++) {
+        if (updated[i] == grades[i] && deltas[i] == 0)
+            continue;
+        if (updated[i] != grades[i]) {
+            histogram[grades[i]]--;
+            histogram[updated[i]]++;
+            changed++;
+        }
+        if (saturated && static_cast<long>(grades[i]) - deltas[i] != updated[i]) {
+            GradeError error;
+            error.index = i;
+            error.grade = grades[i];
+            error.delta = deltas[i];
+            errors.push_back(error);
+        }
+    }
+    grades.swap(updated);
+    return changed;
+}
+
+// Exception implementations
+const char *PackedRoster::IndexOutOfRangeException::what() const throw() {
+    return "Roster index out of range!";
+}
+
+const char *PackedRoster::SizeMismatchException::what() const throw() {
+    return "One delta per bureaucrat is required!";
+}
+
+// Insertion operator overload
+std::ostream &operator<<(std::ostream &out, const PackedRoster &src) {
+    out << "PackedRoster of " << src.getSize() << " bureaucrats";
+    for (size_t i = 0; i < src.getSize(); i++)
+        out << "\n  " << src.getName(i) << ", grade " << src.getGrade(i);
+    return out;
+}
@@ -0,0 +1,95 @@
+#include "PermissionMatrix.hpp"
+#include "AForm.hpp"
+#include "Intern.hpp"
+
+// Default constructor - no type registered, nothing allowed
+PermissionMatrix::PermissionMatrix() : type_count(0) {
+}
+
+// Copy constructor
+PermissionMatrix::PermissionMatrix(const PermissionMatrix &src) : type_count(src.type_count) {
+    for (int i = 0; i < MAX_TYPES; i++) {
+        can_sign[i] = src.can_sign[i];
+        can_execute[i] = src.can_execute[i];
+    }
+}
+
+// Assignment operator
+PermissionMatrix &PermissionMatrix::operator=(const PermissionMatrix &src) {
+    if (this == &src)
+        return *this;
+
+    for (int i = 0; i < MAX_TYPES; i++) {
+        this->can_sign[i] = src.can_sign[i];
+        this->can_execute[i] = src.can_execute[i];
+    }
+    this->type_count = src.type_count;
+    return *this;
+}
+
+// Destructor
+PermissionMatrix::~PermissionMatrix() {
+}
+
+PermissionMatrix PermissionMatrix::standard() {
+    PermissionMatrix matrix;
+
+    for (int type = 0; type < Intern::FORM_TYPE_COUNT; type++)
+        matrix.registerType(type, Intern::getGradeToSign(type), Intern::getGradeToExecute(type));
+    return matrix;
+}
+
+// Getter
+int PermissionMatrix::getTypeCount() const {
+    return type_count;
+}
+
+// Grades at or above (numerically at or below) the requirement are allowed
+void PermissionMatrix::registerType(int typeId, int gradeToSign, int gradeToExecute) {
+    if (typeId < 0 || typeId >= MAX_TYPES)
+        throw PermissionMatrix::InvalidTypeException();
+    if (gradeToSign < 1 || gradeToExecute < 1)
+        throw AForm::GradeTooHighException();
+    if (gradeToSign > 150 || gradeToExecute > 150)
+        throw AForm::GradeTooLowException();
+
+    can_sign[typeId].reset();
+    can_execute[typeId].reset();
+    for (int grade = 1; grade < GRADE_COUNT; grade++) {
+        can_sign[typeId][grade] = grade <= gradeToSign;
+        can_execute[typeId][grade] = grade <= gradeToExecute;
+    }
+    if (typeId >= type_count)
+        type_count = typeId + 1;
+}
+
+// Single queries - out of range grades or types are simply not allowed
+bool PermissionMatrix::canSign(int grade, int typeId) const {
+    if (static_cast<unsigned int>(typeId) >= MAX_TYPES
+        || static_cast<unsigned int>(grade) >= GRADE_COUNT)
+        return false;
+    return can_sign[typeId][grade];
+}
+
+bool PermissionMatrix::canExecute(int grade, int typeId) const {
+    if (static_cast<unsigned int>(typeId) >= MAX_TYPES
+        || static_cast<unsigned int>(grade) >= GRADE_COUNT)
+        return false;
+    return can_execute[typeId][grade];
+}
+
+// Batch queries over parallel arrays of (grade, type) pairs
+void PermissionMatrix::canSign(const int *grades, const int *typeIds, size_t count, bool *out) const {
+    for (size_t i = 0; i < count; i++)
+        out[i] = canSign(grades[i], typeIds[i]);
+}
+
+void PermissionMatrix::canExecute(const int *grades, const int *typeIds, size_t count, bool *out) const {
+    for (size_t i = 0; i < count; i++)
+        out[i] = canExecute(grades[i], typeIds[i]);
+}
+
+// Exception implementation
+const char *PermissionMatrix::InvalidTypeException::what() const throw() {
+    return "Form type id out of range!";
+}
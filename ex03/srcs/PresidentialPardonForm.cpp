@@ -1,14 +1,20 @@
 #include "PresidentialPardonForm.hpp"
 #include "Bureaucrat.hpp"
+#include "Trace.hpp"
 
 // Default constructor
 PresidentialPardonForm::PresidentialPardonForm()
-    : AForm("PresidentialPardonForm", 25, 5), target("default") {
+    : AForm("PresidentialPardonForm", GRADE_TO_SIGN, GRADE_TO_EXECUTE), target(TargetPool::intern("default")) {
 }
 
 // Parameterized constructor
 PresidentialPardonForm::PresidentialPardonForm(const std::string &target)
-    : AForm("PresidentialPardonForm", 25, 5), target(target) {
+    : AForm("PresidentialPardonForm", GRADE_TO_SIGN, GRADE_TO_EXECUTE), target(TargetPool::intern(target)) {
+}
+
+// Parameterized constructor - grades from a form type configuration
+PresidentialPardonForm::PresidentialPardonForm(const std::string &target, int gradeToSign, int gradeToExecute)
+    : AForm("PresidentialPardonForm", gradeToSign, gradeToExecute), target(TargetPool::intern(target)) {
 }
 
 // Copy constructor
@@ -32,15 +38,31 @@ PresidentialPardonForm::~PresidentialPardonForm() {
 }
 
 // Getter
-std::string PresidentialPardonForm::getTarget() const {
+const std::string &PresidentialPardonForm::getTarget() const {
+    return TargetPool::get(target);
+}
+
+TargetPool::Handle PresidentialPardonForm::getTargetHandle() const {
     return target;
 }
 
+// Exchange base members and target handles without copying strings
+void PresidentialPardonForm::swap(PresidentialPardonForm &other) {
+    AForm::swap(other);
+    std::swap(target, other.target);
+}
+
 // Execute implementation
 void PresidentialPardonForm::execute(Bureaucrat const &executor) const {
     // Check execution requirements (signed and grade)
     checkExecution(executor);
+    FORM_TRACE3(execute_start, getName().c_str(), getTarget().c_str(), executor.getGrade());
     
     // Inform about the pardon
-    std::cout << target << " has been pardoned by Zaphod Beeblebrox." << std::endl;
+    std::cout << getTarget() << " has been pardoned by Zaphod Beeblebrox." << std::endl;
+    FORM_TRACE3(execute_done, getName().c_str(), getTarget().c_str(), 1);
+}
+
+void swap(PresidentialPardonForm &a, PresidentialPardonForm &b) {
+    a.swap(b);
 }
@@ -0,0 +1,101 @@
+#include "ReportWriter.hpp"
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+#include <cstring>
+
+// Constructor
+ReportWriter::ReportWriter(std::ostream &_out, size_t capacity)
+    : out(_out), buffer(capacity < 64 ? 64 : capacity), used(0) {
+}
+
+// Destructor
+ReportWriter::~ReportWriter() {
+    flush();
+}
+
+// Getter
+size_t ReportWriter::getBufferedSize() const {
+    return used;
+}
+
+// Private helpers
+void ReportWriter::reserve(size_t length) {
+    if (used + length > buffer.size())
+        flush();
+}
+
+void ReportWriter::append(const char *text, size_t length) {
+    if (length > buffer.size()) {
+        flush();
+        out.write(text, length);
+        return;
+    }
+    reserve(length);
+    std::memcpy(&buffer[used], text, length);
+    used += length;
+}
+
+void ReportWriter::append(const std::string &text) {
+    append(text.data(), text.size());
+}
+
+// Digits are produced backwards into a small scratch area
+void ReportWriter::appendInt(int value) {
+    char digits[12];
+    size_t length = 0;
+    unsigned int magnitude = value < 0 ? 0u - static_cast<unsigned int>(value) : value;
+
+    do {
+        digits[sizeof(digits) - 1 - length++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude);
+    if (value < 0)
+        digits[sizeof(digits) - 1 - length++] = '-';
+    append(digits + sizeof(digits) - length, length);
+}
+
+// Same text as operator<<(std::ostream &, const AForm &)
+void ReportWriter::write(const AForm &form) {
+    static const char prefix[] = "AForm ";
+    static const char is_signed[] = ", signed: ";
+    static const char sign_grade[] = ", grade required to sign: ";
+    static const char execute_grade[] = ", grade required to execute: ";
+
+    append(prefix, sizeof(prefix) - 1);
+    append(form.getName());
+    append(is_signed, sizeof(is_signed) - 1);
+    if (form.getIsSigned())
+        append("yes", 3);
+    else
+        append("no", 2);
+    append(sign_grade, sizeof(sign_grade) - 1);
+    appendInt(form.getGradeToSign());
+    append(execute_grade, sizeof(execute_grade) - 1);
+    appendInt(form.getGradeToExecute());
+}
+
+// Same text as operator<<(std::ostream &, const Bureaucrat &)
+void ReportWriter::write(const Bureaucrat &bureaucrat) {
+    static const char grade[] = ", bureaucrat grade ";
+
+    append(bureaucrat.getName());
+    append(grade, sizeof(grade) - 1);
+    appendInt(bureaucrat.getGrade());
+}
+
+void ReportWriter::write(const std::string &text) {
+    append(text);
+}
+
+void ReportWriter::write(char c) {
+    reserve(1);
+    buffer[used++] = c;
+}
+
+void ReportWriter::flush() {
+    if (used) {
+        out.write(&buffer[0], used);
+        used = 0;
+    }
+    out.flush();
+}
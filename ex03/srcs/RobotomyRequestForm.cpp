@@ -1,14 +1,43 @@
 #include "RobotomyRequestForm.hpp"
 #include "Bureaucrat.hpp"
+#include "Trace.hpp"
+#include <pthread.h>
+
+unsigned int RobotomyRequestForm::process_seed;
+
+void RobotomyRequestForm::seedProcess() {
+    process_seed = static_cast<unsigned int>(std::time(NULL));
+}
+
+// pthread_once seeds the process before any thread draws; each thread
+// then derives its own state from the seed and its arrival order
+int RobotomyRequestForm::nextRandom() {
+    static pthread_once_t seeded = PTHREAD_ONCE_INIT;
+    static volatile unsigned int threads = 0;
+    static __thread unsigned int state;
+    static __thread bool has_state = false;
+
+    if (!has_state) {
+        pthread_once(&seeded, seedProcess);
+        state = process_seed + __sync_add_and_fetch(&threads, 1) * 0x9E3779B9U;
+        has_state = true;
+    }
+    return rand_r(&state);
+}
 
 // Default constructor
 RobotomyRequestForm::RobotomyRequestForm()
-    : AForm("RobotomyRequestForm", 72, 45), target("default") {
+    : AForm("RobotomyRequestForm", GRADE_TO_SIGN, GRADE_TO_EXECUTE), target(TargetPool::intern("default")) {
 }
 
 // Parameterized constructor
 RobotomyRequestForm::RobotomyRequestForm(const std::string &target)
-    : AForm("RobotomyRequestForm", 72, 45), target(target) {
+    : AForm("RobotomyRequestForm", GRADE_TO_SIGN, GRADE_TO_EXECUTE), target(TargetPool::intern(target)) {
+}
+
+// Parameterized constructor - grades from a form type configuration
+RobotomyRequestForm::RobotomyRequestForm(const std::string &target, int gradeToSign, int gradeToExecute)
+    : AForm("RobotomyRequestForm", gradeToSign, gradeToExecute), target(TargetPool::intern(target)) {
 }
 
 // Copy constructor
@@ -32,28 +61,46 @@ RobotomyRequestForm::~RobotomyRequestForm() {
 }
 
 // Getter
-std::string RobotomyRequestForm::getTarget() const {
+const std::string &RobotomyRequestForm::getTarget() const {
+    return TargetPool::get(target);
+}
+
+TargetPool::Handle RobotomyRequestForm::getTargetHandle() const {
     return target;
 }
 
+// Exchange base members and target handles without copying strings
+void RobotomyRequestForm::swap(RobotomyRequestForm &other) {
+    AForm::swap(other);
+    std::swap(target, other.target);
+}
+
 // Execute implementation
 void RobotomyRequestForm::execute(Bureaucrat const &executor) const {
+    perform(executor);
+}
+
+// Execute and report whether the robotomy succeeded - execute() runs
+// through here, so the execute probes live here too
+bool RobotomyRequestForm::perform(Bureaucrat const &executor) const {
     // Check execution requirements (signed and grade)
     checkExecution(executor);
+    FORM_TRACE3(execute_start, getName().c_str(), getTarget().c_str(), executor.getGrade());
     
     // Make drilling noises
     std::cout << "* DRILLING NOISES * BZZZzzzzZZZZ... WHIRRRRR... BZZZZZZ..." << std::endl;
     
-    // 50% success rate
-    static bool seeded = false;
-    if (!seeded) {
-        std::srand(std::time(NULL));
-        seeded = true;
-    }
-    
-    if (std::rand() % 2 == 0) {
-        std::cout << target << " has been robotomized successfully!" << std::endl;
-    } else {
-        std::cout << "Robotomy of " << target << " failed!" << std::endl;
+    // SUCCESS_PERCENT success rate (50%)
+    if (nextRandom() % 100 < SUCCESS_PERCENT) {
+        std::cout << getTarget() << " has been robotomized successfully!" << std::endl;
+        FORM_TRACE3(execute_done, getName().c_str(), getTarget().c_str(), 1);
+        return true;
     }
+    std::cout << "Robotomy of " << getTarget() << " failed!" << std::endl;
+    FORM_TRACE3(execute_done, getName().c_str(), getTarget().c_str(), 0);
+    return false;
+}
+
+void swap(RobotomyRequestForm &a, RobotomyRequestForm &b) {
+    a.swap(b);
 }
@@ -0,0 +1,215 @@
+#include "RobotomySimulation.hpp"
+#include "RobotomyRequestForm.hpp"
+#include <cmath>
+#include <ctime>
+#include <pthread.h>
+
+// Result default constructor
+RobotomySimulation::Result::Result() : successes(0), failures(0) {
+}
+
+unsigned long RobotomySimulation::Result::total() const {
+    return successes + failures;
+}
+
+double RobotomySimulation::Result::successRatio() const {
+    if (total() == 0)
+        return 0.0;
+    return static_cast<double>(successes) / total();
+}
+
+// Wilson score bound, sign selects the lower (-1) or upper (+1) limit
+static double wilsonBound(unsigned long successes, unsigned long total, int sign) {
+    if (total == 0)
+        return 0.0;
+    const double z = 1.96;
+    double n = total;
+    double p = successes / n;
+    double centre = p + z * z / (2 * n);
+    double margin = z * std::sqrt(p * (1 - p) / n + z * z / (4 * n * n));
+    return (centre + sign * margin) / (1 + z * z / n);
+}
+
+double RobotomySimulation::Result::lowerBound() const {
+    return wilsonBound(successes, total(), -1);
+}
+
+double RobotomySimulation::Result::upperBound() const {
+    return wilsonBound(successes, total(), 1);
+}
+
+// Default constructor - same odds as RobotomyRequestForm::execute
+RobotomySimulation::RobotomySimulation()
+    : success_percent(RobotomyRequestForm::SUCCESS_PERCENT), thread_count(MAX_THREADS),
+      seed(std::time(NULL)), next_word(0) {
+}
+
+// Parameterized constructor - one scenario with its own odds and seed
+RobotomySimulation::RobotomySimulation(int _success_percent, unsigned long long _seed,
+                                       size_t _thread_count)
+    : success_percent(_success_percent), thread_count(_thread_count), seed(_seed), next_word(0) {
+    if (_success_percent < 0 || _success_percent > 100)
+        throw RobotomySimulation::InvalidSuccessPercentException();
+    if (_thread_count == 0 || _thread_count > MAX_THREADS)
+        throw RobotomySimulation::InvalidThreadCountException();
+}
+
+// Copy constructor
+RobotomySimulation::RobotomySimulation(const RobotomySimulation &src)
+    : groups(src.groups), slices(src.slices), success_percent(src.success_percent),
+      thread_count(src.thread_count), seed(src.seed), next_word(src.next_word) {
+}
+
+// Assignment operator
+RobotomySimulation &RobotomySimulation::operator=(const RobotomySimulation &src) {
+    if (this == &src)
+        return *this;
+
+    this->groups = src.groups;
+    this->slices = src.slices;
+    this->success_percent = src.success_percent;
+    this->thread_count = src.thread_count;
+    this->seed = src.seed;
+    this->next_word = src.next_word;
+    return *this;
+}
+
+// Destructor
+RobotomySimulation::~RobotomySimulation() {
+}
+
+// Getters
+int RobotomySimulation::getSuccessPercent() const {
+    return success_percent;
+}
+
+size_t RobotomySimulation::getThreadCount() const {
+    return thread_count;
+}
+
+const std::vector<RobotomySimulation::Result> &RobotomySimulation::getSlices() const {
+    return slices;
+}
+
+const RobotomySimulation::Result &RobotomySimulation::getResult(const std::string &group) const {
+    std::map<std::string, Result>::const_iterator it = groups.find(group);
+    if (it == groups.end())
+        throw RobotomySimulation::GroupNotFoundException();
+    return it->second;
+}
+
+RobotomySimulation::Result RobotomySimulation::getTotal() const {
+    Result total;
+    for (std::map<std::string, Result>::const_iterator it = groups.begin(); it != groups.end(); ++it) {
+        total.successes += it->second.successes;
+        total.failures += it->second.failures;
+    }
+    return total;
+}
+
+// Private helpers
+unsigned long long RobotomySimulation::randomWord(unsigned long long index) const {
+    unsigned long long z = seed + (index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Draws count outcomes, BATCH_WIDTH 16-bit lanes per random word, and
+// returns how many of them succeeded. Words are independent of each
+// other, so iterations carry no dependency and the loop batches freely.
+unsigned long RobotomySimulation::drawBatch(unsigned long long first_word, unsigned long count) const {
+    const unsigned long threshold = static_cast<unsigned long>(success_percent) * 65536 / 100;
+    const unsigned long whole = count / BATCH_WIDTH;
+    unsigned long successes = 0;
+
+    for (unsigned long w = 0; w < whole; w++) {
+        unsigned long long word = randomWord(first_word + w);
+        for (int lane = 0; lane < BATCH_WIDTH; lane++)
+            successes += ((word >> (lane * 16)) & 0xFFFF) < threshold;
+    }
+    if (count % BATCH_WIDTH != 0) {
+        unsigned long long word = randomWord(first_word + whole);
+        for (unsigned long lane = 0; lane < count % BATCH_WIDTH; lane++)
+            successes += ((word >> (lane * 16)) & 0xFFFF) < threshold;
+    }
+    return successes;
+}
+
+// Thread body: draw one slice; each slice is written by its thread alone
+void *RobotomySimulation::runSlice(void *arg) {
+    Slice *slice = static_cast<Slice *>(arg);
+
+    slice->successes = slice->simulation->drawBatch(slice->first_word, slice->count);
+    return NULL;
+}
+
+// Simulate count robotomies for a target group, without printing anything.
+// The draws are cut into whole-word slices, one per thread, this one
+// included; a slice whose thread cannot be started is drawn here.
+const RobotomySimulation::Result &RobotomySimulation::run(const std::string &group, unsigned long count) {
+    const unsigned long long words = (count + BATCH_WIDTH - 1) / BATCH_WIDTH;
+    size_t threads = thread_count;
+    if (words < threads)
+        threads = words == 0 ? 1 : words;
+
+    std::vector<Slice> work(threads);
+    std::vector<pthread_t> handles(threads);
+    std::vector<bool> started(threads, false);
+    for (size_t i = 0; i < threads; i++) {
+        unsigned long long begin = words * i / threads;
+        unsigned long long end = words * (i + 1) / threads;
+        unsigned long long last = end * BATCH_WIDTH < count ? end * BATCH_WIDTH : count;
+        work[i].simulation = this;
+        work[i].first_word = next_word + begin;
+        work[i].count = last - begin * BATCH_WIDTH;
+        work[i].successes = 0;
+    }
+    for (size_t i = 1; i < threads; i++)
+        started[i] = pthread_create(&handles[i], NULL, runSlice, &work[i]) == 0;
+    runSlice(&work[0]);
+    for (size_t i = 1; i < threads; i++) {
+        if (started[i])
+            pthread_join(handles[i], NULL);
+        else
+            runSlice(&work[i]);
+    }
+    next_word += words;
+
+    Result &result = groups[group];
+    slices.assign(threads, Result());
+    for (size_t i = 0; i < threads; i++) {
+        slices[i].successes = work[i].successes;
+        slices[i].failures = work[i].count - work[i].successes;
+        result.successes += slices[i].successes;
+        result.failures += slices[i].failures;
+    }
+    return result;
+}
+
+void RobotomySimulation::reset() {
+    groups.clear();
+    slices.clear();
+    next_word = 0;
+}
+
+// Exception implementations
+const char *RobotomySimulation::InvalidSuccessPercentException::what() const throw() {
+    return "Success percent must be between 0 and 100!";
+}
+
+const char *RobotomySimulation::InvalidThreadCountException::what() const throw() {
+    return "Thread count must be between 1 and MAX_THREADS!";
+}
+
+const char *RobotomySimulation::GroupNotFoundException::what() const throw() {
+    return "Target group not found!";
+}
+
+// Insertion operator overload
+std::ostream &operator<<(std::ostream &out, const RobotomySimulation::Result &src) {
+    out << src.successes << " succeeded, " << src.failures << " failed"
+        << ", success ratio: " << src.successRatio()
+        << " (95% CI " << src.lowerBound() << " - " << src.upperBound() << ")";
+    return out;
+}
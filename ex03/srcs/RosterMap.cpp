@@ -0,0 +1,197 @@
+#include "RosterMap.hpp"
+#include "Bureaucrat.hpp"
+#include <cstring>
+#include <sched.h>
+
+// Constructor - sized for capacity entries at no more than 50% load
+RosterMap::RosterMap(size_t capacity) : mask(0), used_slots(0), size(0) {
+    size_t slot_count = 16;
+
+    for (int i = 0; i < LOCK_STRIPES; i++)
+        locks[i] = 0;
+
+    while (slot_count < capacity * 2)
+        slot_count *= 2;
+    Slot empty;
+    empty.hash = 0;
+    empty.key = 0;
+    empty.value = NULL;
+    slots.assign(slot_count, empty);
+    mask = slot_count - 1;
+}
+
+// Destructor
+RosterMap::~RosterMap() {
+}
+
+// Getters
+size_t RosterMap::getSize() const {
+    return __atomic_load_n(&size, __ATOMIC_RELAXED);
+}
+
+size_t RosterMap::getCapacity() const {
+    return slots.size() / 2;
+}
+
+// Private helpers
+unsigned long RosterMap::hashName(const char *name, size_t length) {
+    unsigned long hash = 2166136261UL;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 16777619UL;
+    }
+    return hash ? hash : 1;
+}
+
+// Compares the slot's own key; its value is never dereferenced
+bool RosterMap::matches(const Slot &slot, const char *name, size_t length) {
+    const std::string &key = TargetPool::get(__atomic_load_n(&slot.key, __ATOMIC_ACQUIRE));
+    return key.size() == length && std::memcmp(key.data(), name, length) == 0;
+}
+
+unsigned long RosterMap::loadHash(const Slot &slot) {
+    return __atomic_load_n(&slot.hash, __ATOMIC_ACQUIRE);
+}
+
+// Pairs with the release store that publishes a value, after its key
+Bureaucrat *RosterMap::loadValue(const Slot &slot) {
+    return __atomic_load_n(&slot.value, __ATOMIC_ACQUIRE);
+}
+
+bool RosterMap::isLive(const Bureaucrat *value) {
+    return value && value != tombstone();
+}
+
+// Marks a removed entry; never dereferenced
+Bureaucrat *RosterMap::tombstone() {
+    static char marker;
+    return reinterpret_cast<Bureaucrat *>(&marker);
+}
+
+// Stripe lock
+RosterMap::StripeLock::StripeLock(RosterMap &map, unsigned long hash)
+    : lock(map.locks[hash % LOCK_STRIPES]) {
+    while (__sync_lock_test_and_set(&lock, 1))
+        sched_yield();
+}
+
+RosterMap::StripeLock::~StripeLock() {
+    __sync_lock_release(&lock);
+}
+
+// Live slot holding name; caller holds the stripe of hash, so no other
+// writer can add or remove this name meanwhile
+RosterMap::Slot *RosterMap::findSlot(unsigned long hash, const char *name, size_t length) {
+    for (size_t i = hash & mask, probes = 0; probes < slots.size(); i = (i + 1) & mask, probes++) {
+        unsigned long slot_hash = loadHash(slots[i]);
+        if (slot_hash == 0)
+            return NULL;
+        if (slot_hash != hash)
+            continue;
+        if (isLive(loadValue(slots[i])) && matches(slots[i], name, length))
+            return &slots[i];
+    }
+    return NULL;
+}
+
+// Store a bureaucrat known to be absent in the first tombstone or empty
+// slot of its probe chain. Tombstones keep their old hash until revived,
+// so chains through them stay intact; a reader that still sees the old
+// hash compares names and moves on.
+void RosterMap::claimSlot(unsigned long hash, TargetPool::Handle key, Bureaucrat &bureaucrat) {
+    for (size_t i = hash & mask, probes = 0; probes < slots.size(); i = (i + 1) & mask, probes++) {
+        if (loadValue(slots[i]) == tombstone()
+            && __sync_bool_compare_and_swap(&slots[i].value, tombstone(), static_cast<Bureaucrat *>(NULL))) {
+            __atomic_store_n(&slots[i].key, key, __ATOMIC_RELEASE);
+            __atomic_store_n(&slots[i].hash, hash, __ATOMIC_RELEASE);
+            __atomic_store_n(&slots[i].value, &bureaucrat, __ATOMIC_RELEASE);
+            __sync_add_and_fetch(&size, 1);
+            return;
+        }
+        if (loadHash(slots[i]) == 0) {
+            // Keep one slot empty so every probe chain ends
+            if (__sync_add_and_fetch(&used_slots, 1) > slots.size() - 1) {
+                __sync_sub_and_fetch(&used_slots, 1);
+                throw RosterMap::MapFullException();
+            }
+            if (__sync_bool_compare_and_swap(&slots[i].hash, 0UL, hash)) {
+                __atomic_store_n(&slots[i].key, key, __ATOMIC_RELEASE);
+                __atomic_store_n(&slots[i].value, &bureaucrat, __ATOMIC_RELEASE);
+                __sync_add_and_fetch(&size, 1);
+                return;
+            }
+            __sync_sub_and_fetch(&used_slots, 1);
+        }
+    }
+    throw RosterMap::MapFullException();
+}
+
+// Lookups
+Bureaucrat *RosterMap::find(const char *name, size_t length) const {
+    unsigned long hash = hashName(name, length);
+
+    for (size_t i = hash & mask, probes = 0; probes < slots.size(); i = (i + 1) & mask, probes++) {
+        unsigned long slot_hash = loadHash(slots[i]);
+        if (slot_hash == 0)
+            return NULL;
+        if (slot_hash != hash)
+            continue;
+        Bureaucrat *value = loadValue(slots[i]);
+        if (isLive(value) && matches(slots[i], name, length))
+            return value;
+    }
+    return NULL;
+}
+
+Bureaucrat *RosterMap::find(const std::string &name) const {
+    return find(name.data(), name.size());
+}
+
+// Add a bureaucrat under its name; returns false if the name is taken
+bool RosterMap::insert(Bureaucrat &bureaucrat) {
+    const std::string &name = bureaucrat.getName();
+    unsigned long hash = hashName(name.data(), name.size());
+    StripeLock lock(*this, hash);
+
+    if (findSlot(hash, name.data(), name.size()))
+        return false;
+    claimSlot(hash, TargetPool::intern(name), bureaucrat);
+    return true;
+}
+
+// Insert, or atomically replace the bureaucrat stored under the same
+// name. Returns the replaced bureaucrat, or NULL if the name was new.
+Bureaucrat *RosterMap::put(Bureaucrat &bureaucrat) {
+    const std::string &name = bureaucrat.getName();
+    unsigned long hash = hashName(name.data(), name.size());
+    StripeLock lock(*this, hash);
+    Slot *slot = findSlot(hash, name.data(), name.size());
+
+    if (!slot) {
+        claimSlot(hash, TargetPool::intern(name), bureaucrat);
+        return NULL;
+    }
+    return __atomic_exchange_n(&slot->value, &bureaucrat, __ATOMIC_ACQ_REL);
+}
+
+bool RosterMap::remove(const char *name, size_t length) {
+    unsigned long hash = hashName(name, length);
+    StripeLock lock(*this, hash);
+    Slot *slot = findSlot(hash, name, length);
+
+    if (!slot)
+        return false;
+    __atomic_store_n(&slot->value, tombstone(), __ATOMIC_RELEASE);
+    __sync_sub_and_fetch(&size, 1);
+    return true;
+}
+
+bool RosterMap::remove(const std::string &name) {
+    return remove(name.data(), name.size());
+}
+
+// Exception implementation
+const char *RosterMap::MapFullException::what() const throw() {
+    return "Roster map is full!";
+}
@@ -0,0 +1,210 @@
+#include "ShardedExecutor.hpp"
+#include "Intern.hpp"
+#include "Bureaucrat.hpp"
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <sched.h>
+
+// Record type telling a worker to exit
+static const unsigned char STOP_RECORD = 0xFF;
+
+// Constructor - workers are forked by start()
+ShardedExecutor::ShardedExecutor(int _worker_count)
+    : rings(NULL), worker_count(_worker_count), next_shard(0), submitted(0) {
+    if (_worker_count < 1)
+        throw ShardedExecutor::InvalidWorkerCountException();
+}
+
+// Destructor
+ShardedExecutor::~ShardedExecutor() {
+    stop();
+}
+
+// Getters
+int ShardedExecutor::getWorkerCount() const {
+    return worker_count;
+}
+
+unsigned long ShardedExecutor::getSubmittedCount() const {
+    return submitted;
+}
+
+bool ShardedExecutor::isRunning() const {
+    return rings != NULL;
+}
+
+// Process id of a shard's worker, -1 once it has exited
+pid_t ShardedExecutor::getWorkerPid(int shard) const {
+    if (shard < 0 || static_cast<size_t>(shard) >= workers.size())
+        throw ShardedExecutor::InvalidWorkerCountException();
+    return workers[shard];
+}
+
+// Build the record a worker needs to recreate, sign and execute the form
+FormRecord ShardedExecutor::makeRecord(const AForm &form, int signer_grade, int executor_grade) {
+    FormRecord record;
+    int typeId = Intern::getFormTypeId(form);
+    const std::string &target = form.getTarget();
+
+    if (typeId < 0)
+        throw Intern::FormNotFoundException();
+    if (signer_grade < 1 || executor_grade < 1)
+        throw Bureaucrat::GradeTooHighException();
+    if (signer_grade > 150 || executor_grade > 150)
+        throw Bureaucrat::GradeTooLowException();
+    if (target.size() > static_cast<size_t>(FormRecord::TARGET_SIZE))
+        throw ShardedExecutor::TargetTooLongException();
+
+    record.type_id = static_cast<unsigned char>(typeId);
+    record.grade_to_sign = static_cast<unsigned char>(form.getGradeToSign());
+    record.grade_to_execute = static_cast<unsigned char>(form.getGradeToExecute());
+    record.signer_grade = static_cast<unsigned char>(signer_grade);
+    record.executor_grade = static_cast<unsigned char>(executor_grade);
+    record.target_length = static_cast<unsigned char>(target.size());
+    std::memcpy(record.target, target.data(), target.size());
+    return record;
+}
+
+// Map one ring per worker and fork the workers
+void ShardedExecutor::start() {
+    if (rings)
+        return;
+
+    void *memory = mmap(NULL, sizeof(Ring) * worker_count, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        throw ShardedExecutor::SystemErrorException();
+    rings = static_cast<Ring *>(memory);
+    for (int i = 0; i < worker_count; i++) {
+        rings[i].head = 0;
+        rings[i].tail = 0;
+    }
+
+    // Flush first so buffered output is not duplicated into the children
+    std::cout.flush();
+    for (int i = 0; i < worker_count; i++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            stop();
+            throw ShardedExecutor::SystemErrorException();
+        }
+        if (pid == 0) {
+            workerLoop(rings[i]);
+            std::cout.flush();
+            _exit(0);
+        }
+        workers.push_back(pid);
+    }
+}
+
+// Reap the worker of a shard if it has exited
+bool ShardedExecutor::isWorkerAlive(size_t shard) {
+    if (workers[shard] < 0)
+        return false;
+    if (waitpid(workers[shard], NULL, WNOHANG) == 0)
+        return true;
+    workers[shard] = -1;
+    return false;
+}
+
+// Producer side: wait for a free slot, fill it, then publish it. While
+// the ring is full the worker is checked, so a dead worker makes push
+// return false instead of spinning forever.
+bool ShardedExecutor::push(size_t shard, const FormRecord &record) {
+    Ring &ring = rings[shard];
+
+    while (ring.head - ring.tail == RING_SIZE) {
+        if (!isWorkerAlive(shard))
+            return false;
+        sched_yield();
+    }
+    ring.slots[ring.head & (RING_SIZE - 1)] = record;
+    __sync_synchronize();
+    ring.head = ring.head + 1;
+    return true;
+}
+
+// Consumer side: run the usual sign/execute logic for every record
+void ShardedExecutor::workerLoop(Ring &ring) {
+    Intern intern;
+
+    while (true) {
+        while (ring.tail == ring.head)
+            sched_yield();
+        __sync_synchronize();
+        FormRecord record = ring.slots[ring.tail & (RING_SIZE - 1)];
+        __sync_synchronize();
+        ring.tail = ring.tail + 1;
+
+        if (record.type_id == STOP_RECORD)
+            return;
+        try {
+            std::string target(record.target, record.target_length);
+            AForm *form = intern.makeForm(record.type_id, target,
+                                          record.grade_to_sign, record.grade_to_execute);
+            Bureaucrat signer("Signer", record.signer_grade);
+            Bureaucrat executor("Executor", record.executor_grade);
+
+            signer.signForm(*form);
+            executor.executeForm(*form);
+            delete form;
+        }
+        catch (std::exception &e) {
+            std::cerr << "Worker exception: " << e.what() << std::endl;
+        }
+    }
+}
+
+// Hand a record to the next worker, round robin
+void ShardedExecutor::submit(const FormRecord &record) {
+    if (record.target_length > FormRecord::TARGET_SIZE)
+        throw ShardedExecutor::TargetTooLongException();
+    if (!rings)
+        start();
+    size_t shard = next_shard;
+    next_shard = (next_shard + 1) % worker_count;
+    if (!push(shard, record))
+        throw ShardedExecutor::WorkerDiedException();
+    submitted++;
+}
+
+// Let workers drain their rings, then reap them
+void ShardedExecutor::stop() {
+    if (!rings)
+        return;
+
+    FormRecord stop_record;
+    std::memset(&stop_record, 0, sizeof(stop_record));
+    stop_record.type_id = STOP_RECORD;
+    for (size_t i = 0; i < workers.size(); i++) {
+        if (isWorkerAlive(i))
+            push(i, stop_record);
+    }
+    for (size_t i = 0; i < workers.size(); i++) {
+        if (workers[i] >= 0)
+            waitpid(workers[i], NULL, 0);
+    }
+    workers.clear();
+
+    munmap(rings, sizeof(Ring) * worker_count);
+    rings = NULL;
+}
+
+// Exception implementations
+const char *ShardedExecutor::InvalidWorkerCountException::what() const throw() {
+    return "Worker count must be at least 1!";
+}
+
+const char *ShardedExecutor::TargetTooLongException::what() const throw() {
+    return "Target is too long for a form record!";
+}
+
+const char *ShardedExecutor::WorkerDiedException::what() const throw() {
+    return "Worker process of this shard has died!";
+}
+
+const char *ShardedExecutor::SystemErrorException::what() const throw() {
+    return "Could not set up worker processes!";
+}
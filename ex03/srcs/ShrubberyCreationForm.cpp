@@ -1,14 +1,20 @@
 #include "ShrubberyCreationForm.hpp"
 #include "Bureaucrat.hpp"
+#include "Trace.hpp"
 
 // Default constructor
 ShrubberyCreationForm::ShrubberyCreationForm()
-    : AForm("ShrubberyCreationForm", 145, 137), target("default") {
+    : AForm("ShrubberyCreationForm", GRADE_TO_SIGN, GRADE_TO_EXECUTE), target(TargetPool::intern("default")) {
 }
 
 // Parameterized constructor
 ShrubberyCreationForm::ShrubberyCreationForm(const std::string &target)
-    : AForm("ShrubberyCreationForm", 145, 137), target(target) {
+    : AForm("ShrubberyCreationForm", GRADE_TO_SIGN, GRADE_TO_EXECUTE), target(TargetPool::intern(target)) {
+}
+
+// Parameterized constructor - grades from a form type configuration
+ShrubberyCreationForm::ShrubberyCreationForm(const std::string &target, int gradeToSign, int gradeToExecute)
+    : AForm("ShrubberyCreationForm", gradeToSign, gradeToExecute), target(TargetPool::intern(target)) {
 }
 
 // Copy constructor
@@ -32,21 +38,33 @@ ShrubberyCreationForm::~ShrubberyCreationForm() {
 }
 
 // Getter
-std::string ShrubberyCreationForm::getTarget() const {
+const std::string &ShrubberyCreationForm::getTarget() const {
+    return TargetPool::get(target);
+}
+
+TargetPool::Handle ShrubberyCreationForm::getTargetHandle() const {
     return target;
 }
 
+// Exchange base members and target handles without copying strings
+void ShrubberyCreationForm::swap(ShrubberyCreationForm &other) {
+    AForm::swap(other);
+    std::swap(target, other.target);
+}
+
 // Execute implementation
 void ShrubberyCreationForm::execute(Bureaucrat const &executor) const {
     // Check execution requirements (signed and grade)
     checkExecution(executor);
+    FORM_TRACE3(execute_start, getName().c_str(), getTarget().c_str(), executor.getGrade());
     
     // Create file and write ASCII trees
-    std::string filename = target + "_shrubbery";
+    std::string filename = getTarget() + "_shrubbery";
     std::ofstream file(filename.c_str());
     
     if (!file.is_open()) {
         std::cerr << "Error: Could not create file " << filename << std::endl;
+        FORM_TRACE3(execute_done, getName().c_str(), getTarget().c_str(), 0);
         return;
     }
     
@@ -81,4 +99,9 @@ void ShrubberyCreationForm::execute(Bureaucrat const &executor) const {
     
     file.close();
     std::cout << "Created shrubbery file: " << filename << std::endl;
+    FORM_TRACE3(execute_done, getName().c_str(), getTarget().c_str(), 1);
+}
+
+void swap(ShrubberyCreationForm &a, ShrubberyCreationForm &b) {
+    a.swap(b);
 }
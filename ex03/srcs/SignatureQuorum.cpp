@@ -0,0 +1,119 @@
+#include "SignatureQuorum.hpp"
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+
+// Constructor - required of the named signers, one seat each and each at
+// least min_grade
+SignatureQuorum::SignatureQuorum(AForm &_form, const std::vector<std::string> &_signers,
+                                 int _required, int _min_grade)
+    : form(_form), signer_count(_signers.size()), required(_required), min_grade(_min_grade),
+      holders(_signers), seats((_signers.size() + BITS_PER_WORD - 1) / BITS_PER_WORD, 0),
+      signatures(0) {
+    if (_required < 1 || static_cast<size_t>(_required) > signer_count)
+        throw SignatureQuorum::InvalidQuorumException();
+    std::vector<std::string> sorted(_signers);
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+        throw SignatureQuorum::DuplicateSignerException();
+    if (_min_grade < 1)
+        throw AForm::GradeTooHighException();
+    if (_min_grade > 150)
+        throw AForm::GradeTooLowException();
+    if (form.quorum || form.getIsSigned())
+        throw SignatureQuorum::FormAlreadyBoundException();
+    // Signers must also meet the form's own requirement
+    if (form.getGradeToSign() < min_grade)
+        min_grade = form.getGradeToSign();
+    form.quorum = this;
+}
+
+// Destructor - hands the signed state back to the form
+SignatureQuorum::~SignatureQuorum() {
+    form.is_signed = isReached();
+    form.quorum = NULL;
+}
+
+// Getters
+size_t SignatureQuorum::getSignerCount() const {
+    return signer_count;
+}
+
+int SignatureQuorum::getRequired() const {
+    return required;
+}
+
+int SignatureQuorum::getMinGrade() const {
+    return min_grade;
+}
+
+int SignatureQuorum::getSignatureCount() const {
+    return __atomic_load_n(&signatures, __ATOMIC_ACQUIRE);
+}
+
+bool SignatureQuorum::isReached() const {
+    return getSignatureCount() >= required;
+}
+
+bool SignatureQuorum::hasSigned(size_t seat) const {
+    if (seat >= signer_count)
+        throw SignatureQuorum::InvalidSeatException();
+    return (seats[seat / BITS_PER_WORD] >> (seat % BITS_PER_WORD)) & 1UL;
+}
+
+const std::string &SignatureQuorum::getHolder(size_t seat) const {
+    if (seat >= signer_count)
+        throw SignatureQuorum::InvalidSeatException();
+    return holders[seat];
+}
+
+// Add the signature of the bureaucrat holding a seat. Repeated
+// signatures are ignored. Returns true for the one signature that
+// completes the quorum; its increment is what makes the form signed.
+bool SignatureQuorum::sign(size_t seat, const Bureaucrat &signer) {
+    if (seat >= signer_count)
+        throw SignatureQuorum::InvalidSeatException();
+    if (signer.getName() != holders[seat])
+        throw SignatureQuorum::NotSeatHolderException();
+    if (signer.getGrade() > min_grade)
+        throw AForm::GradeTooLowException();
+
+    unsigned long bit = 1UL << (seat % BITS_PER_WORD);
+    unsigned long previous = __sync_fetch_and_or(&seats[seat / BITS_PER_WORD], bit);
+    if (previous & bit)
+        return false;
+    if (__sync_add_and_fetch(&signatures, 1) != required)
+        return false;
+    FORM_TRACE4(sign, form.getName().c_str(), form.getGradeToSign(), signer.getGrade(), 1);
+    return true;
+}
+
+// Exception implementations
+const char *SignatureQuorum::InvalidQuorumException::what() const throw() {
+    return "Quorum must be between 1 and the number of signers!";
+}
+
+const char *SignatureQuorum::InvalidSeatException::what() const throw() {
+    return "Invalid signer seat!";
+}
+
+const char *SignatureQuorum::DuplicateSignerException::what() const throw() {
+    return "A signer can hold only one seat!";
+}
+
+const char *SignatureQuorum::NotSeatHolderException::what() const throw() {
+    return "Signer does not hold this seat!";
+}
+
+const char *SignatureQuorum::FormAlreadyBoundException::what() const throw() {
+    return "Form is already signed or under another quorum!";
+}
+
+// Insertion operator overload
+std::ostream &operator<<(std::ostream &out, const SignatureQuorum &src) {
+    out << "SignatureQuorum " << src.getSignatureCount() << "/" << src.getRequired()
+        << " of " << src.getSignerCount() << " signers (grade " << src.getMinGrade()
+        << " or better), quorum " << (src.isReached() ? "reached" : "pending");
+    return out;
+}
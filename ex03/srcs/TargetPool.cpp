@@ -0,0 +1,125 @@
+#include "TargetPool.hpp"
+#include <sched.h>
+
+// Zero-initialized before any constructor runs, so forms created during
+// static initialization can use the pool too
+std::string *volatile TargetPool::chunks[TargetPool::MAX_CHUNKS];
+volatile size_t TargetPool::count;
+TargetPool::Index *volatile TargetPool::index;
+volatile int TargetPool::lock;
+
+// Append lock
+TargetPool::Lock::Lock() {
+    while (__sync_lock_test_and_set(&lock, 1))
+        sched_yield();
+}
+
+TargetPool::Lock::~Lock() {
+    __sync_lock_release(&lock);
+}
+
+// Private helpers
+
+// FNV-1a
+unsigned long TargetPool::hashTarget(const std::string &target) {
+    unsigned long hash = 2166136261UL;
+
+    for (size_t i = 0; i < target.size(); i++) {
+        hash ^= static_cast<unsigned char>(target[i]);
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+bool TargetPool::find(const Index *index, const std::string &target, unsigned long hash, Handle &handle) {
+    if (!index)
+        return false;
+    for (size_t i = hash & index->mask;; i = (i + 1) & index->mask) {
+        Handle slot = index->slots[i];
+        if (slot == 0)
+            return false;
+        if (get(slot - 1) == target) {
+            handle = slot - 1;
+            return true;
+        }
+    }
+}
+
+// Caller holds the lock; the string of handle is already published
+void TargetPool::insert(Index *index, unsigned long hash, Handle handle) {
+    size_t i = hash & index->mask;
+
+    while (index->slots[i] != 0)
+        i = (i + 1) & index->mask;
+    __sync_synchronize();
+    index->slots[i] = handle + 1;
+}
+
+// Caller holds the lock; builds an index twice as large and publishes it
+TargetPool::Index *TargetPool::grow(Index *current) {
+    size_t capacity = current ? (current->mask + 1) * 2 : 256;
+    Handle *slots = new Handle[capacity]();
+    Index *bigger;
+    try {
+        bigger = new Index;
+    }
+    catch (...) {
+        delete[] slots;
+        throw;
+    }
+
+    bigger->mask = capacity - 1;
+    bigger->slots = slots;
+    bigger->previous = current;
+    for (Handle handle = 0; handle < count; handle++)
+        insert(bigger, hashTarget(get(handle)), handle);
+    __atomic_store_n(&index, bigger, __ATOMIC_RELEASE);
+    return bigger;
+}
+
+// Return the handle of target, adding it on first use
+TargetPool::Handle TargetPool::intern(const std::string &target) {
+    unsigned long hash = hashTarget(target);
+    Handle handle;
+
+    if (find(__atomic_load_n(&index, __ATOMIC_ACQUIRE), target, hash, handle))
+        return handle;
+
+    Lock guard;
+    Index *current = index;
+    if (find(current, target, hash, handle))
+        return handle;
+    if (count / CHUNK_SIZE >= MAX_CHUNKS)
+        throw TargetPool::PoolFullException();
+    if (!current || (count + 1) * 2 > current->mask + 1)
+        current = grow(current);
+
+    handle = static_cast<Handle>(count);
+    if (!chunks[handle / CHUNK_SIZE])
+        chunks[handle / CHUNK_SIZE] = new std::string[CHUNK_SIZE];
+    chunks[handle / CHUNK_SIZE][handle % CHUNK_SIZE] = target;
+    __atomic_store_n(&count, handle + 1, __ATOMIC_RELEASE);
+    insert(current, hash, handle);
+    return handle;
+}
+
+// The acquire load pairs with the release store of count in intern, so
+// the string of any handle below it is fully visible
+const std::string &TargetPool::get(Handle handle) {
+    if (handle >= __atomic_load_n(&count, __ATOMIC_ACQUIRE))
+        throw TargetPool::InvalidHandleException();
+    return chunks[handle / CHUNK_SIZE][handle % CHUNK_SIZE];
+}
+
+size_t TargetPool::getSize() {
+    return count;
+}
+
+// Exception implementations
+const char *TargetPool::InvalidHandleException::what() const throw() {
+    return "Invalid target handle!";
+}
+
+const char *TargetPool::PoolFullException::what() const throw() {
+    return "Target pool is full!";
+}
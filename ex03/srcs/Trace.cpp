@@ -0,0 +1,14 @@
+#include "Trace.hpp"
+
+#ifdef FORM_TRACE_USDT
+// Probe semaphores, referenced from the probes' ELF notes. A tracer
+// increments them while attached; they must live in the .probes section.
+# define FORM_TRACE_SEMAPHORE(probe) \
+    volatile unsigned short bureaucracy_##probe##_semaphore __attribute__((section(".probes"))) = 0
+
+FORM_TRACE_SEMAPHORE(sign);
+FORM_TRACE_SEMAPHORE(check_execution);
+FORM_TRACE_SEMAPHORE(execute_start);
+FORM_TRACE_SEMAPHORE(execute_done);
+FORM_TRACE_SEMAPHORE(make_form);
+#endif
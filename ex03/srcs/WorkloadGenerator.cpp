@@ -0,0 +1,152 @@
+#include "WorkloadGenerator.hpp"
+#include "Intern.hpp"
+#include <sstream>
+
+// Default configuration - an even mix of valid forms over the full grade range
+WorkloadGenerator::Config::Config()
+    : shrubbery_weight(1), robotomy_weight(1), pardon_weight(1), invalid_percent(0),
+      signer_min_grade(1), signer_max_grade(150),
+      executor_min_grade(1), executor_max_grade(150),
+      target_count(100), seed(42) {
+}
+
+// Default constructor
+WorkloadGenerator::WorkloadGenerator() : config() {
+    setup();
+}
+
+// Parameterized constructor
+WorkloadGenerator::WorkloadGenerator(const Config &_config) : config(_config) {
+    setup();
+}
+
+// Copy constructor
+WorkloadGenerator::WorkloadGenerator(const WorkloadGenerator &src)
+    : config(src.config), form_names(src.form_names), invalid_names(src.invalid_names),
+      targets(src.targets), shrubbery_limit(src.shrubbery_limit),
+      robotomy_limit(src.robotomy_limit), invalid_limit(src.invalid_limit), state(src.state) {
+}
+
+// Assignment operator
+WorkloadGenerator &WorkloadGenerator::operator=(const WorkloadGenerator &src) {
+    if (this == &src)
+        return *this;
+
+    this->config = src.config;
+    this->form_names = src.form_names;
+    this->invalid_names = src.invalid_names;
+    this->targets = src.targets;
+    this->shrubbery_limit = src.shrubbery_limit;
+    this->robotomy_limit = src.robotomy_limit;
+    this->invalid_limit = src.invalid_limit;
+    this->state = src.state;
+    return *this;
+}
+
+// Destructor
+WorkloadGenerator::~WorkloadGenerator() {
+}
+
+// Getter
+const WorkloadGenerator::Config &WorkloadGenerator::getConfig() const {
+    return config;
+}
+
+// Validate the configuration and precompute every string and threshold
+void WorkloadGenerator::setup() {
+    int total_weight = config.shrubbery_weight + config.robotomy_weight + config.pardon_weight;
+
+    if (config.shrubbery_weight < 0 || config.robotomy_weight < 0 || config.pardon_weight < 0
+        || total_weight == 0
+        || config.invalid_percent < 0 || config.invalid_percent > 100
+        || config.signer_min_grade < 1 || config.signer_max_grade > 150
+        || config.signer_min_grade > config.signer_max_grade
+        || config.executor_min_grade < 1 || config.executor_max_grade > 150
+        || config.executor_min_grade > config.executor_max_grade
+        || config.target_count == 0)
+        throw WorkloadGenerator::InvalidConfigException();
+
+    form_names.clear();
+    for (int i = 0; i < Intern::FORM_TYPE_COUNT; i++)
+        form_names.push_back(Intern::getFormTypeName(i));
+
+    // Typical mistakes seen in requests, all rejected by Intern::makeForm
+    invalid_names.clear();
+    invalid_names.push_back("coffee making");
+    invalid_names.push_back("robotomy requets");
+    invalid_names.push_back("Presidential Pardon");
+    invalid_names.push_back("");
+
+    targets.clear();
+    targets.reserve(config.target_count);
+    for (size_t i = 0; i < config.target_count; i++) {
+        std::ostringstream name;
+        name << "target_" << i;
+        targets.push_back(name.str());
+    }
+
+    shrubbery_limit = static_cast<unsigned int>(config.shrubbery_weight * 65536.0 / total_weight);
+    robotomy_limit = static_cast<unsigned int>((config.shrubbery_weight + config.robotomy_weight)
+                                               * 65536.0 / total_weight);
+    invalid_limit = static_cast<unsigned int>(config.invalid_percent * 65536 / 100);
+    state = config.seed ? config.seed : 1;
+}
+
+// xorshift64
+unsigned long long WorkloadGenerator::nextRandom() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// One random word is split into four 16-bit draws: type, validity and both grades
+void WorkloadGenerator::next(WorkloadRequest &request) {
+    unsigned long long word = nextRandom();
+    unsigned int type_draw = word & 0xFFFF;
+    unsigned int invalid_draw = (word >> 16) & 0xFFFF;
+    unsigned int signer_draw = (word >> 32) & 0xFFFF;
+    unsigned int executor_draw = (word >> 48) & 0xFFFF;
+    int signer_range = config.signer_max_grade - config.signer_min_grade + 1;
+    int executor_range = config.executor_max_grade - config.executor_min_grade + 1;
+
+    if (invalid_draw < invalid_limit)
+        request.form_name = &invalid_names[type_draw % invalid_names.size()];
+    else if (type_draw < shrubbery_limit)
+        request.form_name = &form_names[Intern::SHRUBBERY_CREATION];
+    else if (type_draw < robotomy_limit)
+        request.form_name = &form_names[Intern::ROBOTOMY_REQUEST];
+    else
+        request.form_name = &form_names[Intern::PRESIDENTIAL_PARDON];
+    request.signer_grade = config.signer_min_grade + ((signer_draw * signer_range) >> 16);
+    request.executor_grade = config.executor_min_grade + ((executor_draw * executor_range) >> 16);
+    request.target = &targets[((nextRandom() >> 32) * targets.size()) >> 32];
+}
+
+void WorkloadGenerator::generate(WorkloadRequest *requests, size_t count) {
+    for (size_t i = 0; i < count; i++)
+        next(requests[i]);
+}
+
+// One tab-separated request per line
+void WorkloadGenerator::write(std::ostream &out, size_t count) {
+    WorkloadRequest request;
+
+    for (size_t i = 0; i < count; i++) {
+        next(request);
+        out << request << '\n';
+    }
+    out.flush();
+}
+
+// Exception implementation
+const char *WorkloadGenerator::InvalidConfigException::what() const throw() {
+    return "Invalid workload configuration!";
+}
+
+// Insertion operator overload
+std::ostream &operator<<(std::ostream &out, const WorkloadRequest &src) {
+    out << *src.form_name << '\t' << *src.target << '\t'
+        << src.signer_grade << '\t' << src.executor_grade;
+    return out;
+}
@@ -0,0 +1,498 @@
+#include "Bureaucrat.hpp"
+#include "PresidentialPardonForm.hpp"
+#include "SignatureQuorum.hpp"
+#include "PackedRoster.hpp"
+#include "Intern.hpp"
+#include "ShardedExecutor.hpp"
+#include <vector>
+#include <fstream>
+#include <cstdlib>
+#include <sstream>
+#include <sys/time.h>
+#include <pthread.h>
+
+static double now() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+// Stand-in for the old Bureaucrat layout: copyable, but no cheap swap
+struct LegacyBureaucrat {
+    std::string name;
+    int grade;
+};
+
+static bool legacyByGrade(const LegacyBureaucrat &a, const LegacyBureaucrat &b) {
+    return a.grade < b.grade;
+}
+
+static bool byGrade(const Bureaucrat &a, const Bureaucrat &b) {
+    return a.getGrade() < b.getGrade();
+}
+
+// Long names, so copies cannot use the small-string buffer
+static std::string makeName(size_t i) {
+    std::ostringstream name;
+    name << "Bureaucrat of the Department of Forms number " << i;
+    return name.str();
+}
+
+// Grow a vector without reallocation copies: move the elements into a
+// larger vector with swap whenever the capacity runs out. Without move
+// constructors this default-constructs every slot of the bigger vector
+// and destroys the emptied old elements, so for Bureaucrat (whose
+// destructor logs) it measures slower than push_back copies and about
+// 3.5x slower than the legacy layout: it is kept as a negative result,
+// use push_back for growth.
+template <typename T>
+static void appendBySwap(std::vector<T> &roster, T &value) {
+    if (roster.size() == roster.capacity()) {
+        std::vector<T> bigger(roster.size() ? roster.size() * 2 : 16);
+        for (size_t i = 0; i < roster.size(); i++)
+            bigger[i].swap(roster[i]);
+        bigger.resize(roster.size());
+        roster.swap(bigger);
+    }
+    roster.resize(roster.size() + 1);
+    roster.back().swap(value);
+}
+
+static void benchRoster(size_t count) {
+    std::vector<LegacyBureaucrat> legacy;
+    std::vector<Bureaucrat> copied;
+    std::vector<Bureaucrat> swapped;
+    double start;
+
+    std::cerr << "roster of " << count << " bureaucrats" << std::endl;
+
+    start = now();
+    for (size_t i = 0; i < count; i++) {
+        LegacyBureaucrat bureaucrat;
+        bureaucrat.name = makeName(i);
+        bureaucrat.grade = 150 - i % 150;
+        legacy.push_back(bureaucrat);
+    }
+    std::cerr << "  growth, legacy copies:      " << now() - start << " s" << std::endl;
+
+    start = now();
+    for (size_t i = 0; i < count; i++)
+        copied.push_back(Bureaucrat(makeName(i), 150 - i % 150));
+    std::cerr << "  growth, push_back copies:   " << now() - start << " s" << std::endl;
+
+    start = now();
+    for (size_t i = 0; i < count; i++) {
+        Bureaucrat bureaucrat(makeName(i), 150 - i % 150);
+        appendBySwap(swapped, bureaucrat);
+    }
+    std::cerr << "  growth, swap into place:    " << now() - start << " s (slower, see appendBySwap)" << std::endl;
+
+    start = now();
+    std::sort(legacy.begin(), legacy.end(), legacyByGrade);
+    std::cerr << "  sort, legacy copies:        " << now() - start << " s" << std::endl;
+
+    start = now();
+    std::sort(swapped.begin(), swapped.end(), byGrade);
+    std::cerr << "  sort, Bureaucrat with swap: " << now() - start << " s" << std::endl;
+}
+
+// Baseline for the quorum benchmark: the same signatures behind a mutex
+struct LockedQuorum {
+    pthread_mutex_t lock;
+    std::vector<bool> seats;
+    int signatures;
+};
+
+struct SignerTask {
+    std::vector<SignatureQuorum *> *quorums;
+    std::vector<LockedQuorum> *locked;
+    const std::vector<Bureaucrat> *signers;
+    size_t first_seat;
+    size_t stride;
+    size_t seats;
+    int completed;
+};
+
+static void *signLockFree(void *arg) {
+    SignerTask &task = *static_cast<SignerTask *>(arg);
+    for (size_t seat = task.first_seat; seat < task.seats; seat += task.stride)
+        for (size_t f = 0; f < task.quorums->size(); f++)
+            task.completed += (*task.quorums)[f]->sign(seat, (*task.signers)[seat]);
+    return NULL;
+}
+
+static void *signLocked(void *arg) {
+    SignerTask &task = *static_cast<SignerTask *>(arg);
+    for (size_t seat = task.first_seat; seat < task.seats; seat += task.stride)
+        for (size_t f = 0; f < task.locked->size(); f++) {
+            LockedQuorum &quorum = (*task.locked)[f];
+            pthread_mutex_lock(&quorum.lock);
+            if (!quorum.seats[seat]) {
+                quorum.seats[seat] = true;
+                quorum.signatures++;
+            }
+            pthread_mutex_unlock(&quorum.lock);
+        }
+    return NULL;
+}
+
+static double runSigners(void *(*body)(void *), std::vector<SignerTask> &tasks, int &completed) {
+    std::vector<pthread_t> threads(tasks.size());
+    double start = now();
+
+    for (size_t t = 0; t < tasks.size(); t++)
+        pthread_create(&threads[t], NULL, body, &tasks[t]);
+    completed = 0;
+    for (size_t t = 0; t < tasks.size(); t++) {
+        pthread_join(threads[t], NULL);
+        completed += tasks[t].completed;
+    }
+    return now() - start;
+}
+
+// Many threads race to sign the same forms; every form must be signed
+// exactly once, by the signature that reaches its quorum. Measured on a
+// single core the bitmap is not faster than the mutex (0.035 s against
+// 0.023 s): with no contention an uncontended lock is cheap, and each
+// signature still pays two locked instructions on shared cache lines.
+static void benchQuorum(size_t forms, size_t seats, size_t threads) {
+    std::vector<Bureaucrat> signers;
+    std::vector<std::string> names;
+    std::vector<PresidentialPardonForm *> pardons;
+    std::vector<SignatureQuorum *> quorums;
+    std::vector<LockedQuorum> locked(forms);
+    std::vector<SignerTask> tasks(threads);
+    int completed;
+
+    std::cerr << "quorum of " << seats / 2 << "/" << seats << " signers on " << forms
+              << " forms, " << threads << " threads" << std::endl;
+
+    signers.reserve(seats);
+    for (size_t s = 0; s < seats; s++) {
+        std::ostringstream name;
+        name << "Signer " << s;
+        names.push_back(name.str());
+        signers.push_back(Bureaucrat(name.str(), 1));
+    }
+    for (size_t f = 0; f < forms; f++) {
+        pardons.push_back(new PresidentialPardonForm("Quorum"));
+        quorums.push_back(new SignatureQuorum(*pardons.back(), names, seats / 2, 25));
+        pthread_mutex_init(&locked[f].lock, NULL);
+        locked[f].seats.assign(seats, false);
+        locked[f].signatures = 0;
+    }
+    for (size_t t = 0; t < threads; t++) {
+        tasks[t].quorums = &quorums;
+        tasks[t].locked = &locked;
+        tasks[t].signers = &signers;
+        tasks[t].first_seat = t;
+        tasks[t].stride = threads;
+        tasks[t].seats = seats;
+        tasks[t].completed = 0;
+    }
+
+    double elapsed = runSigners(signLockFree, tasks, completed);
+    size_t signed_forms = 0;
+    for (size_t f = 0; f < forms; f++)
+        signed_forms += pardons[f]->getIsSigned() && quorums[f]->getSignatureCount() == static_cast<int>(seats);
+    std::cerr << "  atomic bitmap:  " << elapsed << " s, " << completed << " quorums completed, "
+              << signed_forms << "/" << forms << " forms signed" << std::endl;
+
+    for (size_t t = 0; t < threads; t++)
+        tasks[t].completed = 0;
+    elapsed = runSigners(signLocked, tasks, completed);
+    std::cerr << "  mutex baseline: " << elapsed << " s" << std::endl;
+
+    for (size_t f = 0; f < forms; f++) {
+        pthread_mutex_destroy(&locked[f].lock);
+        delete quorums[f];
+        delete pardons[f];
+    }
+}
+
+// Annual review: one delta per bureaucrat, applied one step at a time on
+// Bureaucrat objects versus in bulk on the packed roster
+static void benchBulkGrades(size_t count) {
+    std::vector<Bureaucrat> roster;
+    PackedRoster packed;
+    std::vector<int> deltas(count);
+    std::vector<PackedRoster::GradeError> errors;
+    size_t saturated = 0;
+    double start;
+
+    std::cerr << "annual review of " << count << " bureaucrats" << std::endl;
+    roster.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        roster.push_back(Bureaucrat("B", 1 + i % 150));
+        packed.add("B", 1 + i % 150);
+        deltas[i] = static_cast<int>(i * 7 % 41) - 20;
+    }
+
+    start = now();
+    for (size_t i = 0; i < count; i++) {
+        try {
+            for (int step = 0; step < deltas[i]; step++)
+                roster[i].incrementGrade();
+            for (int step = 0; step > deltas[i]; step--)
+                roster[i].decrementGrade();
+        }
+        catch (std::exception &) {
+            saturated++;
+        }
+    }
+    std::cerr << "  increment/decrement: " << now() - start << " s, "
+              << saturated << " out of range" << std::endl;
+
+    start = now();
+    packed.applyDeltas(deltas, errors);
+    std::cerr << "  packed applyDeltas:  " << now() - start << " s, "
+              << errors.size() << " out of range" << std::endl;
+}
+
+// Rejection-heavy traffic: a grade 100 clerk signs a stream of forms and
+// only shrubberies get through. Full forms are allocated up front,
+// descriptors never are.
+static void benchDescriptors(size_t count) {
+    const char *names[] = {"shrubbery creation", "robotomy request", "presidential pardon"};
+    Intern intern;
+    Bureaucrat clerk("Clerk", 100);
+    std::vector<std::string> targets;
+    std::vector<AForm *> forms;
+    std::vector<FormDescriptor> descriptors;
+    size_t accepted = 0;
+    double start;
+
+    std::cerr << "rejection-heavy stream of " << count << " forms" << std::endl;
+    for (size_t i = 0; i < 100; i++)
+        targets.push_back(makeName(i));
+
+    start = now();
+    forms.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        forms.push_back(intern.makeForm(names[i % 3], targets[i % 100]));
+    for (size_t i = 0; i < count; i++) {
+        if (clerk.getGrade() <= forms[i]->getGradeToSign()) {
+            forms[i]->beSigned(clerk);
+            accepted++;
+        }
+    }
+    for (size_t i = 0; i < count; i++)
+        delete forms[i];
+    std::cerr << "  AForm objects: " << now() - start << " s, " << count << " allocations, "
+              << sizeof(RobotomyRequestForm) << "+ bytes per form, " << accepted << " accepted" << std::endl;
+
+    accepted = 0;
+    start = now();
+    descriptors.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        descriptors.push_back(intern.makeFormDescriptor(names[i % 3], targets[i % 100]));
+    for (size_t i = 0; i < count; i++) {
+        if (clerk.getGrade() <= descriptors[i].getGradeToSign()) {
+            descriptors[i].beSigned(clerk);
+            accepted++;
+        }
+    }
+    std::cerr << "  descriptors:   " << now() - start << " s, 0 allocations, "
+              << sizeof(FormDescriptor) << " bytes per form, " << accepted << " accepted" << std::endl;
+}
+
+// One heap object per makeForm call versus one buffer per makeForms batch
+static void benchFormBatch(size_t count) {
+    const char *names[] = {"shrubbery creation", "robotomy request", "presidential pardon"};
+    Intern intern;
+    std::vector<std::string> formNames;
+    std::vector<std::string> targets;
+    std::vector<AForm *> forms(count);
+    FormBatch batch;
+    double start;
+
+    std::cerr << "creating and freeing " << count << " forms" << std::endl;
+    for (size_t i = 0; i < count; i++) {
+        formNames.push_back(names[i % 3]);
+        targets.push_back(i % 2 ? "home" : "garden");
+    }
+
+    start = now();
+    for (size_t i = 0; i < count; i++)
+        forms[i] = intern.makeForm(formNames[i], targets[i]);
+    for (size_t i = 0; i < count; i++)
+        delete forms[i];
+    std::cerr << "  makeForm per form: " << now() - start << " s, " << count << " allocations" << std::endl;
+
+    start = now();
+    intern.makeForms(formNames, targets, batch);
+    batch.clear();
+    std::cerr << "  makeForms batch:   " << now() - start << " s, 1 allocation" << std::endl;
+}
+
+struct InternTask {
+    const std::vector<std::string> *targets;
+    std::vector<TargetPool::Handle> handles;
+    size_t rounds;
+};
+
+static void *internTargets(void *arg) {
+    InternTask &task = *static_cast<InternTask *>(arg);
+    const std::vector<std::string> &targets = *task.targets;
+
+    task.handles.resize(targets.size());
+    for (size_t round = 0; round < task.rounds; round++)
+        for (size_t i = 0; i < targets.size(); i++)
+            task.handles[i] = TargetPool::intern(targets[(i + round) % targets.size()]);
+    return NULL;
+}
+
+// Threads intern the same high-cardinality target stream; every thread
+// must get the same handle for the same target
+static void benchTargetPool(size_t distinct, size_t rounds, size_t threads) {
+    std::vector<std::string> targets;
+    std::vector<InternTask> tasks(threads);
+    std::vector<pthread_t> workers(threads);
+    size_t mismatches = 0;
+
+    std::cerr << "target pool, " << distinct << " targets interned " << rounds
+              << " times by " << threads << " threads" << std::endl;
+    for (size_t i = 0; i < distinct; i++)
+        targets.push_back(makeName(i) + " target");
+
+    double start = now();
+    for (size_t t = 0; t < threads; t++) {
+        tasks[t].targets = &targets;
+        tasks[t].rounds = rounds;
+        pthread_create(&workers[t], NULL, internTargets, &tasks[t]);
+    }
+    for (size_t t = 0; t < threads; t++)
+        pthread_join(workers[t], NULL);
+    double elapsed = now() - start;
+
+    for (size_t t = 0; t < threads; t++)
+        for (size_t i = 0; i < distinct; i++)
+            mismatches += TargetPool::get(tasks[t].handles[i]) != targets[(i + rounds - 1) % distinct];
+    std::cerr << "  " << elapsed << " s, " << TargetPool::getSize() << " pooled strings, "
+              << mismatches << " mismatches" << std::endl;
+}
+
+// Thread-pool counterpart of ShardedExecutor: the same records, run by
+// pthreads sharing one queue instead of forked workers with one ring each
+struct RecordPool {
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    pthread_cond_t drained;
+    std::vector<FormRecord> records;
+    size_t next;
+    size_t completed;
+    bool stopping;
+};
+
+// Same work as a ShardedExecutor worker does for one record
+static void runRecord(const FormRecord &record) {
+    AForm *form = Intern::makeForm(record.type_id, std::string(record.target, record.target_length),
+                                   record.grade_to_sign, record.grade_to_execute);
+    Bureaucrat signer("Signer", record.signer_grade);
+    Bureaucrat executor("Executor", record.executor_grade);
+
+    signer.signForm(*form);
+    executor.executeForm(*form);
+    delete form;
+}
+
+static void *poolWorker(void *arg) {
+    RecordPool &pool = *static_cast<RecordPool *>(arg);
+
+    pthread_mutex_lock(&pool.lock);
+    while (true) {
+        while (pool.next == pool.records.size() && !pool.stopping)
+            pthread_cond_wait(&pool.ready, &pool.lock);
+        if (pool.next == pool.records.size())
+            break;
+        FormRecord record = pool.records[pool.next++];
+        pthread_mutex_unlock(&pool.lock);
+        runRecord(record);
+        pthread_mutex_lock(&pool.lock);
+        if (++pool.completed == pool.records.size())
+            pthread_cond_signal(&pool.drained);
+    }
+    pthread_mutex_unlock(&pool.lock);
+    return NULL;
+}
+
+// Throughput covers submitting and executing every record; drain latency
+// is the wait from the last submission until every record has run.
+// ShardedExecutor only reports completion through stop(), so its drain
+// includes the workers exiting; its throughput includes the forks.
+static void benchShardedExecutor(size_t count, size_t workers) {
+    std::vector<FormRecord> records(count);
+    std::cerr << count << " form records on " << workers << " workers" << std::endl;
+    for (size_t i = 0; i < count; i++) {
+        std::ostringstream target;
+        target << "Prisoner " << i % 64;
+        PresidentialPardonForm pardon(target.str());
+        records[i] = ShardedExecutor::makeRecord(pardon, 1, 1);
+    }
+
+    double start = now();
+    ShardedExecutor executor(workers);
+    executor.start();
+    for (size_t i = 0; i < count; i++)
+        executor.submit(records[i]);
+    double submitted = now();
+    executor.stop();
+    double end = now();
+    std::cerr << "  sharded processes: " << count / (end - start) << " records/s, drain "
+              << end - submitted << " s" << std::endl;
+
+    RecordPool pool;
+    std::vector<pthread_t> threads(workers);
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.ready, NULL);
+    pthread_cond_init(&pool.drained, NULL);
+    pool.records.reserve(count);
+    pool.next = 0;
+    pool.completed = 0;
+    pool.stopping = false;
+
+    start = now();
+    for (size_t t = 0; t < workers; t++)
+        pthread_create(&threads[t], NULL, poolWorker, &pool);
+    for (size_t i = 0; i < count; i++) {
+        pthread_mutex_lock(&pool.lock);
+        pool.records.push_back(records[i]);
+        pthread_cond_signal(&pool.ready);
+        pthread_mutex_unlock(&pool.lock);
+    }
+    submitted = now();
+    pthread_mutex_lock(&pool.lock);
+    while (pool.completed < count)
+        pthread_cond_wait(&pool.drained, &pool.lock);
+    end = now();
+    pool.stopping = true;
+    pthread_cond_broadcast(&pool.ready);
+    pthread_mutex_unlock(&pool.lock);
+    for (size_t t = 0; t < workers; t++)
+        pthread_join(threads[t], NULL);
+    std::cerr << "  thread pool:       " << count / (end - start) << " records/s, drain "
+              << end - submitted << " s" << std::endl;
+
+    pthread_cond_destroy(&pool.drained);
+    pthread_cond_destroy(&pool.ready);
+    pthread_mutex_destroy(&pool.lock);
+}
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? std::atol(argv[1]) : 200000;
+
+    // The core classes log every destruction; keep that out of the timings
+    std::ofstream null_stream("/dev/null");
+    std::streambuf *console = std::cout.rdbuf(null_stream.rdbuf());
+
+    benchRoster(count);
+    benchQuorum(64, 4096, 8);
+    benchBulkGrades(count * 10);
+    benchDescriptors(count);
+    benchFormBatch(count);
+    benchTargetPool(count / 4, 20, argc > 2 ? std::atol(argv[2]) : 8);
+    benchShardedExecutor(count / 10, 4);
+
+    std::cout.rdbuf(console);
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include "FormService.hpp"
+#include <fstream>
+#include <csignal>
+
+static FormService *service = NULL;
+
+static void handleSignal(int signal) {
+    (void)signal;
+    if (service)
+        service->stop();
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <socket path> [-q]" << std::endl;
+        return 1;
+    }
+
+    // -q silences the per-form output of the core classes
+    std::ofstream null_stream("/dev/null");
+    std::streambuf *console = std::cout.rdbuf();
+    if (argc > 2 && std::string(argv[2]) == "-q")
+        std::cout.rdbuf(null_stream.rdbuf());
+
+    try {
+        FormService formService(argv[1]);
+        service = &formService;
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
+        std::signal(SIGPIPE, SIG_IGN);
+
+        formService.open();
+        std::cerr << "formd listening on " << argv[1] << std::endl;
+        formService.run();
+        std::cerr << "formd handled " << formService.getHandledCount() << " requests" << std::endl;
+        service = NULL;
+    }
+    catch (std::exception &e) {
+        std::cout.rdbuf(console);
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout.rdbuf(console);
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "FormClient.hpp"
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <poll.h>
+#include <sys/time.h>
+
+// One closed-loop virtual user: make -> sign -> execute -> release
+struct Session {
+    FormClient *client;
+    int step;
+    unsigned int form_id;
+    double sent_at;
+};
+
+static double now() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static void sendNext(Session &session) {
+    std::string frame;
+
+    switch (session.step) {
+    case 0:
+        FormProtocol::makeRequest(frame, "presidential pardon", "Load Test");
+        break;
+    case 1:
+        FormProtocol::signRequest(frame, session.form_id, 1);
+        break;
+    case 2:
+        FormProtocol::executeRequest(frame, session.form_id, 1);
+        break;
+    default:
+        FormProtocol::releaseRequest(frame, session.form_id);
+        break;
+    }
+    session.sent_at = now();
+    session.client->send(frame);
+}
+
+// Run total requests spread over concurrency connections
+static void runLevel(const std::string &path, int concurrency, long total) {
+    std::vector<Session> sessions(concurrency);
+    std::vector<struct pollfd> fds(concurrency);
+    std::vector<double> latencies;
+    long sent = 0;
+
+    latencies.reserve(total);
+    for (int i = 0; i < concurrency; i++) {
+        sessions[i].client = new FormClient();
+        sessions[i].client->connect(path);
+        sessions[i].step = 0;
+        sessions[i].form_id = 0;
+        fds[i].fd = sessions[i].client->getFd();
+        fds[i].events = POLLIN;
+    }
+
+    double start = now();
+    for (int i = 0; i < concurrency && sent < total; i++, sent++)
+        sendNext(sessions[i]);
+    while (static_cast<long>(latencies.size()) < total) {
+        if (poll(&fds[0], fds.size(), 1000) <= 0)
+            break;
+        for (int i = 0; i < concurrency; i++) {
+            if (!(fds[i].revents & POLLIN))
+                continue;
+            FormProtocol::Frame frame;
+            sessions[i].client->receive(frame);
+            latencies.push_back(now() - sessions[i].sent_at);
+            if (frame.opcode == FormProtocol::MAKE && frame.status == FormProtocol::OK)
+                sessions[i].form_id = FormProtocol::readId(frame.payload);
+            sessions[i].step = (sessions[i].step + 1) % 4;
+            if (sent < total) {
+                sendNext(sessions[i]);
+                sent++;
+            }
+        }
+    }
+    double elapsed = now() - start;
+
+    // Drain outstanding releases so the daemon does not keep forms around
+    for (int i = 0; i < concurrency; i++) {
+        while (sessions[i].step != 0) {
+            FormProtocol::Frame frame;
+            sendNext(sessions[i]);
+            sessions[i].client->receive(frame);
+            sessions[i].step = (sessions[i].step + 1) % 4;
+        }
+        delete sessions[i].client;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    double p99 = latencies.empty() ? 0 : latencies[(latencies.size() * 99) / 100];
+    std::cout << "concurrency " << concurrency
+              << ": " << static_cast<long>(latencies.size() / elapsed) << " req/s"
+              << ", p99 " << p99 * 1e6 << " us" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <socket path> [requests per level] [max concurrency]"
+                  << std::endl;
+        return 1;
+    }
+    long total = argc > 2 ? std::atol(argv[2]) : 20000;
+    int max_concurrency = argc > 3 ? std::atoi(argv[3]) : 16;
+
+    try {
+        for (int concurrency = 1; concurrency <= max_concurrency; concurrency *= 2)
+            runLevel(argv[1], concurrency, total);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
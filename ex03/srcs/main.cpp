@@ -4,6 +4,32 @@
 #include "RobotomyRequestForm.hpp"
 #include "PresidentialPardonForm.hpp"
 #include "Intern.hpp"
+#include "RobotomySimulation.hpp"
+#include "ExecutionQueue.hpp"
+#include "ExecutionCache.hpp"
+#include "FormScheduler.hpp"
+#include "ShardedExecutor.hpp"
+#include "FormProtocol.hpp"
+#include "WorkloadGenerator.hpp"
+#include "BureaucracySnapshot.hpp"
+#include "ReportWriter.hpp"
+#include "OutcomeAggregator.hpp"
+#include "EpochReclaimer.hpp"
+#include "RosterMap.hpp"
+#include "PermissionMatrix.hpp"
+#include "FormGraph.hpp"
+#include "SignatureQuorum.hpp"
+#include "PackedRoster.hpp"
+#include "FormIndex.hpp"
+#include "FormTypeRegistry.hpp"
+#include "FormDescriptor.hpp"
+#include <sstream>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <csignal>
+#include <pthread.h>
+#include <unistd.h>
 
 void testInternCreation() {
     std::cout << "\n========== INTERN CREATION TESTS ==========" << std::endl;
@@ -11,15 +37,13 @@ void testInternCreation() {
     try {
         std::cout << "\n--- Test 1: Create Shrubbery Form ---" << std::endl;
         Intern intern;
-        AForm *form = intern.makeForm("shrubbery creation", "home");
+        FormHandle form = intern.makeFormHandle("shrubbery creation", "home");
         
         std::cout << *form << std::endl;
         
         Bureaucrat bob("Bob", 100);
         bob.signForm(*form);
         bob.executeForm(*form);
-        
-        delete form;
     }
     catch (std::exception &e) {
         std::cerr << "Exception: " << e.what() << std::endl;
@@ -28,15 +52,13 @@ void testInternCreation() {
     try {
         std::cout << "\n--- Test 2: Create Robotomy Form ---" << std::endl;
         Intern intern;
-        AForm *form = intern.makeForm("robotomy request", "Bender");
+        FormHandle form = intern.makeFormHandle("robotomy request", "Bender");
         
         std::cout << *form << std::endl;
         
         Bureaucrat alice("Alice", 40);
         alice.signForm(*form);
         alice.executeForm(*form);
-        
-        delete form;
     }
     catch (std::exception &e) {
         std::cerr << "Exception: " << e.what() << std::endl;
@@ -45,15 +67,13 @@ void testInternCreation() {
     try {
         std::cout << "\n--- Test 3: Create Presidential Form ---" << std::endl;
         Intern intern;
-        AForm *form = intern.makeForm("presidential pardon", "Arthur Dent");
+        FormHandle form = intern.makeFormHandle("presidential pardon", "Arthur Dent");
         
         std::cout << *form << std::endl;
         
         Bureaucrat president("President", 1);
         president.signForm(*form);
         president.executeForm(*form);
-        
-        delete form;
     }
     catch (std::exception &e) {
         std::cerr << "Exception: " << e.what() << std::endl;
@@ -173,6 +193,59 @@ void testInternCopy() {
     }
 }
 
+template <typename T>
+T &lvalue();
+
+// Compile-time check: is "T = const T" accessible? A protected or private
+// operator= is a substitution failure, not an error.
+template <typename T>
+struct IsAssignable {
+    template <typename U>
+    static char test(char (*)[sizeof(lvalue<U>() = lvalue<const U>())]);
+    template <typename U>
+    static long test(...);
+    static const bool value = sizeof(test<T>(0)) == 1;
+};
+
+void testFormAssignment() {
+    std::cout << "\n========== FORM ASSIGNMENT ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Assignment copies target and signed state ---" << std::endl;
+        Bureaucrat boss("Boss", 1);
+        ShrubberyCreationForm home("home");
+        ShrubberyCreationForm garden("garden");
+        boss.signForm(garden);
+        home = garden;
+        std::cout << "Target: " << home.getTarget()
+                  << ", signed: " << (home.getIsSigned() ? "yes" : "no") << std::endl;
+        
+        std::cout << "\n--- Test 2: Assigning an unsigned form clears the signature ---" << std::endl;
+        ShrubberyCreationForm yard("yard");
+        home = yard;
+        std::cout << "Target: " << home.getTarget()
+                  << ", signed: " << (home.getIsSigned() ? "yes" : "no") << std::endl;
+        
+        std::cout << "\n--- Test 3: Assigned Bureaucrat takes name and grade ---" << std::endl;
+        Bureaucrat clerk("Clerk", 150);
+        RosterMap roster(4);
+        roster.insert(clerk);
+        clerk = boss;
+        std::cout << clerk << std::endl;
+        std::cout << "Roster still finds it as Clerk: "
+                  << (roster.find("Clerk") == &clerk ? "yes" : "no") << std::endl;
+        
+        std::cout << "\n--- Test 4: No assignment across form types ---" << std::endl;
+        std::cout << "AForm assignable through a base reference: "
+                  << (IsAssignable<AForm>::value ? "yes" : "no") << std::endl;
+        std::cout << "ShrubberyCreationForm assignable: "
+                  << (IsAssignable<ShrubberyCreationForm>::value ? "yes" : "no") << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+}
+
 void testExampleFromSubject() {
     std::cout << "\n========== EXAMPLE FROM SUBJECT ==========" << std::endl;
     
@@ -250,13 +323,1084 @@ void testEdgeCases() {
     }
 }
 
+void testRobotomySimulation() {
+    std::cout << "\n========== ROBOTOMY SIMULATION ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Default odds over a large batch ---" << std::endl;
+        RobotomySimulation simulation(RobotomyRequestForm::SUCCESS_PERCENT, 42);
+        
+        simulation.run("Bender", 1000000);
+        simulation.run("Employees", 250000);
+        std::cout << "Bender: " << simulation.getResult("Bender") << std::endl;
+        std::cout << "Employees: " << simulation.getResult("Employees") << std::endl;
+        std::cout << "Total: " << simulation.getTotal() << std::endl;
+        
+        std::cout << "\n--- Test 2: Custom scenario odds ---" << std::endl;
+        RobotomySimulation risky(10, 7);
+        std::cout << "Risky: " << risky.run("Interns", 100000) << std::endl;
+        
+        std::cout << "\n--- Test 3: Threads add up to the single-thread run ---" << std::endl;
+        RobotomySimulation single(RobotomyRequestForm::SUCCESS_PERCENT, 42, 1);
+        RobotomySimulation split(RobotomyRequestForm::SUCCESS_PERCENT, 42, 4);
+        const RobotomySimulation::Result &alone = single.run("Bender", 1000003);
+        const RobotomySimulation::Result &shared = split.run("Bender", 1000003);
+        RobotomySimulation::Result sum;
+        for (size_t i = 0; i < split.getSlices().size(); i++) {
+            sum.successes += split.getSlices()[i].successes;
+            sum.failures += split.getSlices()[i].failures;
+        }
+        std::cout << split.getSlices().size() << " slices sum to the run: "
+                  << (sum.successes == shared.successes && sum.failures == shared.failures ? "yes" : "no")
+                  << ", match one thread: "
+                  << (shared.successes == alone.successes && shared.failures == alone.failures ? "yes" : "no")
+                  << std::endl;
+        
+        std::cout << "\n--- Test 4: Invalid odds ---" << std::endl;
+        RobotomySimulation invalid(101, 1);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+// Runs on a queue worker; results are delivered one at a time
+void onExecuted(const AForm &form, const ExecutionQueue::Result &result, void *data) {
+    std::vector<std::string> *completed = static_cast<std::vector<std::string> *>(data);
+    completed->push_back(form.getTarget() + (result.status == ExecutionQueue::DONE ? "" : " (failed)"));
+}
+
+void testAsyncExecution() {
+    std::cout << "\n========== ASYNC EXECUTION ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Executions overlap while the caller signs ---" << std::endl;
+        ExecutionQueue queue;
+        Bureaucrat boss("Boss", 1);
+        ShrubberyCreationForm garden("garden");
+        ShrubberyCreationForm park("park");
+        PresidentialPardonForm pardon("Ford Prefect");
+        std::vector<std::string> completed;
+        
+        boss.signForm(garden);
+        boss.signForm(park);
+        ExecutionQueue::Ticket first = queue.submit(garden, boss, onExecuted, &completed);
+        queue.submit(park, boss, onExecuted, &completed);
+        boss.signForm(pardon);  // While the shrubberies are being written
+        ExecutionQueue::Ticket last = boss.executeFormAsync(pardon, queue);
+        
+        queue.wait(last).rethrow();
+        std::cout << queue.getWorkerCount() << " workers, callbacks in submission order:";
+        for (size_t i = 0; i < completed.size(); i++)
+            std::cout << " " << completed[i];
+        std::cout << std::endl;
+        std::cout << "First done: " << (queue.isDone(first) ? "yes" : "no")
+                  << ", pending: " << queue.getPendingCount() << std::endl;
+        
+        std::cout << "\n--- Test 2: Error propagation ---" << std::endl;
+        ShrubberyCreationForm unsigned_form("office");
+        ExecutionQueue::Ticket failed = boss.executeFormAsync(unsigned_form, queue);
+        queue.wait(failed).rethrow();
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+void testExecutionCache() {
+    std::cout << "\n========== EXECUTION CACHE ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Resubmitted pardons run once ---" << std::endl;
+        ExecutionCache cache(2, 60);
+        Bureaucrat president("President", 1);
+        PresidentialPardonForm first("Arthur Dent");
+        PresidentialPardonForm resubmitted("Arthur Dent");
+        PresidentialPardonForm other("Trillian");
+        
+        president.signForm(first);
+        president.signForm(resubmitted);
+        president.signForm(other);
+        cache.execute(first, president);
+        std::cout << "Resubmission executed: "
+                  << (cache.execute(resubmitted, president) ? "yes" : "no") << std::endl;
+        cache.execute(other, president);
+        std::cout << cache << std::endl;
+        
+        std::cout << "\n--- Test 2: Robotomies are never cached ---" << std::endl;
+        RobotomyRequestForm robotomy("Bender");
+        president.signForm(robotomy);
+        cache.execute(robotomy, president);
+        bool retried = cache.execute(robotomy, president);
+        std::cout << "Retry executed: " << (retried ? "yes" : "no") << std::endl;
+        
+        std::cout << "\n--- Test 3: Hits still check the executor grade ---" << std::endl;
+        Bureaucrat intern("Intern", 150);
+        cache.execute(resubmitted, intern);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+struct SchedulerWorker {
+    FormScheduler *scheduler;
+    const Bureaucrat *executor;
+    const AForm *form;
+    bool runs;
+};
+
+// Schedules three forms, or drains whatever is queued so far
+void *schedulerWorker(void *arg) {
+    SchedulerWorker *worker = static_cast<SchedulerWorker *>(arg);
+
+    if (worker->runs)
+        worker->scheduler->runAll(*worker->executor);
+    else
+        for (int i = 0; i < 3; i++)
+            worker->scheduler->schedule(*worker->form, FormScheduler::fromNow(60 * 1000000LL), i);
+    return NULL;
+}
+
+void testFormScheduler() {
+    std::cout << "\n========== DEADLINE SCHEDULER ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Urgent pardon jumps the shrubbery backlog ---" << std::endl;
+        FormScheduler scheduler;
+        Bureaucrat boss("Boss", 1);
+        ShrubberyCreationForm bulk("garden");
+        RobotomyRequestForm robotomy("Marvin");
+        PresidentialPardonForm pardon("Zaphod");
+        PresidentialPardonForm late("Slartibartfast");
+        FormScheduler::Deadline minute = FormScheduler::fromNow(60 * 1000000LL);
+        
+        boss.signForm(bulk);
+        boss.signForm(robotomy);
+        boss.signForm(pardon);
+        boss.signForm(late);
+        scheduler.schedule(bulk, FormScheduler::NO_DEADLINE);
+        scheduler.schedule(robotomy, minute);
+        scheduler.schedule(pardon, minute);
+        scheduler.schedule(late, FormScheduler::fromNow(-1));
+        
+        scheduler.runAll(boss);
+        std::cout << scheduler << std::endl;
+        
+        std::cout << "\n--- Test 2: A millisecond late is a miss ---" << std::endl;
+        scheduler.schedule(pardon, FormScheduler::fromNow(1000));
+        usleep(2000);
+        scheduler.runAll(boss);
+        std::cout << scheduler << std::endl;
+        
+        std::cout << "\n--- Test 3: Concurrent schedulers and runners ---" << std::endl;
+        FormScheduler shared;
+        SchedulerWorker workers[4];
+        pthread_t threads[4];
+        for (int i = 0; i < 4; i++) {
+            workers[i].scheduler = &shared;
+            workers[i].executor = &boss;
+            workers[i].form = &pardon;
+            workers[i].runs = i >= 2;  // Two threads schedule, two run
+        }
+        for (int i = 0; i < 4; i++)
+            pthread_create(&threads[i], NULL, schedulerWorker, &workers[i]);
+        for (int i = 0; i < 4; i++)
+            pthread_join(threads[i], NULL);
+        shared.runAll(boss);
+        std::cout << "Pending: " << shared.getPendingCount()
+                  << ", executed: " << shared.getExecutedCount() << " of 6" << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+}
+
+void testShardedExecutor() {
+    std::cout << "\n========== SHARDED WORKER PROCESSES ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Records executed by two workers ---" << std::endl;
+        Intern intern;
+        ShardedExecutor executor(2);
+        AForm *robotomy = intern.makeForm("robotomy request", "Bender");
+        AForm *pardon = intern.makeForm("presidential pardon", "Arthur Dent");
+        FormRecord records[2];
+        
+        records[0] = ShardedExecutor::makeRecord(*robotomy, 40, 40);
+        records[1] = ShardedExecutor::makeRecord(*pardon, 20, 10);  // Executor too low
+        delete robotomy;
+        delete pardon;
+        
+        executor.start();
+        for (int i = 0; i < 2; i++)
+            executor.submit(records[i]);
+        executor.stop();
+        std::cout << "Submitted " << executor.getSubmittedCount() << " records" << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+    
+    try {
+        std::cout << "\n--- Test 2: Dead worker is reported, not waited on ---" << std::endl;
+        ShardedExecutor executor(1);
+        PresidentialPardonForm pardon("Arthur Dent");
+        FormRecord record = ShardedExecutor::makeRecord(pardon, 1, 1);
+        
+        executor.start();
+        kill(executor.getWorkerPid(0), SIGKILL);
+        for (size_t i = 0; i <= ShardedExecutor::RING_SIZE; i++)
+            executor.submit(record);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+    
+    try {
+        std::cout << "\n--- Test 3: Target too long for a record ---" << std::endl;
+        PresidentialPardonForm pardon(std::string(FormRecord::TARGET_SIZE + 1, 'x'));
+        ShardedExecutor::makeRecord(pardon, 1, 1);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+    
+    try {
+        std::cout << "\n--- Test 4: Hand-built record with an oversized length ---" << std::endl;
+        PresidentialPardonForm pardon("Arthur Dent");
+        FormRecord record = ShardedExecutor::makeRecord(pardon, 1, 1);
+        record.target_length = FormRecord::TARGET_SIZE + 1;
+        ShardedExecutor executor(1);
+        executor.submit(record);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+}
+
+void testFormProtocol() {
+    std::cout << "\n========== FORM PROTOCOL ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Grades keep their value on the wire ---" << std::endl;
+        std::string wire;
+        size_t offset = 0;
+        FormProtocol::Frame frame;
+        FormProtocol::signRequest(wire, 7, 42);
+        FormProtocol::signRequest(wire, 7, 257);
+        FormProtocol::decode(wire, offset, frame);
+        std::cout << "Form " << FormProtocol::readId(frame.payload)
+                  << ", grade " << FormProtocol::readGrade(frame.payload) << std::endl;
+        
+        std::cout << "\n--- Test 2: Out-of-range grade rejected on decode ---" << std::endl;
+        FormProtocol::decode(wire, offset, frame);
+        FormProtocol::readGrade(frame.payload);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+void testWorkloadGenerator() {
+    std::cout << "\n========== WORKLOAD GENERATOR ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Sample requests ---" << std::endl;
+        WorkloadGenerator::Config config;
+        config.pardon_weight = 2;
+        config.invalid_percent = 10;
+        config.signer_min_grade = 20;
+        config.signer_max_grade = 80;
+        config.target_count = 5;
+        WorkloadGenerator generator(config);
+        generator.write(std::cout, 5);
+        
+        std::cout << "\n--- Test 2: Mix over a large stream ---" << std::endl;
+        std::vector<WorkloadRequest> requests(1000000);
+        int rejected = 0;
+        generator.generate(&requests[0], requests.size());
+        for (size_t i = 0; i < requests.size(); i++) {
+            if (Intern::getFormTypeId(*requests[i].form_name) < 0)
+                rejected++;
+        }
+        std::cout << "Invalid form names: " << rejected << " / " << requests.size() << std::endl;
+        
+        std::cout << "\n--- Test 3: Invalid configuration ---" << std::endl;
+        config.target_count = 0;
+        WorkloadGenerator invalid(config);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+void testSnapshot() {
+    std::cout << "\n========== SNAPSHOT AND RESTORE ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Save roster and pending forms ---" << std::endl;
+        Bureaucrat alice("Alice", 40);
+        Bureaucrat bob("Bob", 140);
+        ShrubberyCreationForm shrub("home");
+        PresidentialPardonForm pardon("home");  // Same target, stored once
+        RobotomyRequestForm routine("Bender", 100, 60);  // Configured grades
+        std::vector<Bureaucrat *> roster;
+        std::vector<AForm *> forms;
+        
+        alice.signForm(shrub);
+        alice.signForm(routine);
+        roster.push_back(&alice);
+        roster.push_back(&bob);
+        forms.push_back(&shrub);
+        forms.push_back(&pardon);
+        forms.push_back(&routine);
+        BureaucracySnapshot::save("bureaucracy.snapshot", roster, forms);
+        
+        std::cout << "\n--- Test 2: Restore from the mapped file ---" << std::endl;
+        BureaucracySnapshot snapshot("bureaucracy.snapshot");
+        for (size_t i = 0; i < snapshot.getBureaucratCount(); i++)
+            std::cout << snapshot.getBureaucratName(i) << ", bureaucrat grade "
+                      << snapshot.getBureaucratGrade(i) << std::endl;
+        AForm *restored = snapshot.makeForm(0);
+        std::cout << *restored << std::endl;
+        delete restored;
+        restored = snapshot.makeForm(2);
+        std::cout << *restored << std::endl;
+        delete restored;
+        
+        std::cout << "\n--- Test 3: Out of range ---" << std::endl;
+        snapshot.getFormTarget(3);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+    
+    try {
+        std::cout << "\n--- Test 4: Misaligned form section ---" << std::endl;
+        std::fstream file("bureaucracy.snapshot", std::ios::in | std::ios::out | std::ios::binary);
+        unsigned char form_offset[8];
+        file.seekg(24);  // Header::form_offset, little-endian
+        file.read(reinterpret_cast<char *>(form_offset), sizeof(form_offset));
+        form_offset[0]++;
+        file.seekp(24);
+        file.write(reinterpret_cast<const char *>(form_offset), sizeof(form_offset));
+        form_offset[0]--;
+        file.seekp(24);
+        file.flush();
+        try {
+            BureaucracySnapshot snapshot("bureaucracy.snapshot");
+        }
+        catch (std::exception &e) {
+            std::cerr << "Caught exception: " << e.what() << std::endl;
+        }
+        file.write(reinterpret_cast<const char *>(form_offset), sizeof(form_offset));
+        file.close();
+        BureaucracySnapshot restored("bureaucracy.snapshot");
+        std::cout << "Realigned snapshot opens with " << restored.getFormCount() << " forms" << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+    
+    try {
+        std::cout << "\n--- Test 5: Section offset crafted to overflow ---" << std::endl;
+        std::fstream file("bureaucracy.snapshot", std::ios::in | std::ios::out | std::ios::binary);
+        const unsigned char huge_offset[8] = {0xF8, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+        file.seekp(16);  // Header::bureaucrat_offset
+        file.write(reinterpret_cast<const char *>(huge_offset), sizeof(huge_offset));
+        file.close();
+        BureaucracySnapshot snapshot("bureaucracy.snapshot");
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+    std::remove("bureaucracy.snapshot");
+}
+
+void testReportWriter() {
+    std::cout << "\n========== REPORT WRITER ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Same text as operator<< ---" << std::endl;
+        Bureaucrat alice("Alice", 7);
+        RobotomyRequestForm robotomy("Bender");
+        PresidentialPardonForm pardon("Arthur Dent");
+        std::ostringstream expected;
+        std::ostringstream actual;
+        
+        alice.signForm(robotomy);
+        expected << alice << '\n' << robotomy << '\n' << pardon << '\n';
+        {
+            ReportWriter writer(actual, 64);  // Tiny buffer to exercise flushing
+            writer.write(alice);
+            writer.write('\n');
+            writer.write(robotomy);
+            writer.write('\n');
+            writer.write(pardon);
+            writer.write('\n');
+        }
+        std::cout << actual.str();
+        std::cout << "Byte-identical: " << (expected.str() == actual.str() ? "yes" : "no") << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+}
+
+void testOutcomeAggregator() {
+    std::cout << "\n========== OUTCOME AGGREGATION ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Two workers, merged summary ---" << std::endl;
+        OutcomeAggregator aggregator(2);
+        Bureaucrat senior("Senior", 3);
+        Bureaucrat junior("Junior", 130);
+        RobotomyRequestForm robotomy("Bender");
+        PresidentialPardonForm pardon("Arthur Dent");
+        ShrubberyCreationForm shrub("Bender");
+        
+        aggregator.getShard(0).sign(robotomy, junior);  // Rejected
+        aggregator.getShard(0).sign(robotomy, senior);
+        aggregator.getShard(0).execute(robotomy, senior);
+        aggregator.getShard(1).execute(pardon, senior);  // Rejected: not signed
+        aggregator.getShard(1).sign(shrub, junior);
+        aggregator.getShard(1).execute(shrub, junior);
+        
+        OutcomeShard summary = aggregator.merge();
+        std::vector<std::pair<std::string, unsigned long> > top;
+        summary.getTopTargets(1, top);
+        std::cout << summary << std::endl;
+        std::cout << "top target: " << top[0].first << " (" << top[0].second << ")" << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+}
+
+void testFormHandles() {
+    std::cout << "\n========== FORM HANDLES ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Shared between sign and execute stages ---" << std::endl;
+        Intern intern;
+        Bureaucrat boss("Boss", 1);
+        FormHandle signStage = intern.makeFormHandle("presidential pardon", "Ford Prefect");
+        FormHandle executeStage = signStage;
+        
+        std::cout << "Owners: " << signStage.getUseCount() << std::endl;
+        boss.signForm(*signStage);
+        signStage.reset();  // Sign stage is done with it
+        std::cout << "Owners: " << executeStage.getUseCount() << std::endl;
+        boss.executeForm(*executeStage);
+        
+        std::cout << "\n--- Test 2: No leak when an exception is thrown ---" << std::endl;
+        FormHandle form = intern.makeFormHandle("robotomy request", "Marvin");
+        Bureaucrat invalid("Invalid", 0);  // Throws, form is still released
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+void testEpochReclaimer() {
+    std::cout << "\n========== EPOCH RECLAMATION ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Retired form outlives its reader ---" << std::endl;
+        EpochReclaimer reclaimer;
+        Intern intern;
+        int reader = reclaimer.registerReader();
+        AForm *published = intern.makeForm("shrubbery creation", "home");
+        
+        {
+            EpochReclaimer::Guard guard(reclaimer, reader);
+            std::cout << "Reader sees: " << *published << std::endl;
+            reclaimer.retire(published);  // Executor is done with it
+            for (int i = 0; i < 3; i++)
+                reclaimer.tryReclaim();
+            std::cout << "Pending while reading: " << reclaimer.getPendingCount() << std::endl;
+        }
+        for (int i = 0; i < 3; i++)
+            reclaimer.tryReclaim();
+        std::cout << "Pending after reader left: " << reclaimer.getPendingCount()
+                  << ", reclaimed: " << reclaimer.getReclaimedCount() << std::endl;
+        reclaimer.unregisterReader(reader);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+}
+
+struct RosterWorker {
+    RosterMap *roster;
+    Bureaucrat *clerks;
+    int count;
+    int errors;
+};
+
+// Cycles its own clerks through the map while checking a shared entry
+static void *rosterWorker(void *arg) {
+    RosterWorker *worker = static_cast<RosterWorker *>(arg);
+    
+    try {
+        for (int round = 0; round < 2000; round++) {
+            for (int i = 0; i < worker->count; i++) {
+                Bureaucrat &clerk = worker->clerks[i];
+                if (!worker->roster->insert(clerk) || worker->roster->find(clerk.getName()) != &clerk)
+                    worker->errors++;
+                if (!worker->roster->find("Boss", 4))
+                    worker->errors++;
+                if (!worker->roster->remove(clerk.getName()) || worker->roster->find(clerk.getName()))
+                    worker->errors++;
+            }
+        }
+    }
+    catch (std::exception &e) {
+        worker->errors++;
+    }
+    return NULL;
+}
+
+void testRosterMap() {
+    std::cout << "\n========== ROSTER MAP ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Lookup by name without allocating ---" << std::endl;
+        RosterMap roster(4);
+        Bureaucrat alice("Alice", 10);
+        Bureaucrat bob("Bob", 100);
+        Bureaucrat promotedBob("Bob", 50);
+        const char request[] = "Bob signs form 42";
+        
+        roster.insert(alice);
+        roster.insert(bob);
+        std::cout << "Duplicate insert: " << (roster.insert(promotedBob) ? "yes" : "no") << std::endl;
+        std::cout << *roster.find(request, 3) << std::endl;
+        
+        std::cout << "\n--- Test 2: Replace and remove ---" << std::endl;
+        roster.put(promotedBob);
+        std::cout << *roster.find("Bob") << std::endl;
+        roster.remove("Alice");
+        std::cout << "Alice found: " << (roster.find("Alice") ? "yes" : "no")
+                  << ", size: " << roster.getSize() << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+    
+    try {
+        std::cout << "\n--- Test 3: Concurrent insert, find and remove ---" << std::endl;
+        const int threads = 4;
+        const int names = 6;
+        RosterMap roster(4);  // 16 slots, fewer than the 24 names cycled through
+        Bureaucrat boss("Boss", 1);
+        std::vector<Bureaucrat> clerks;
+        std::vector<RosterWorker> workers(threads);
+        std::vector<pthread_t> ids(threads);
+        
+        clerks.reserve(threads * names);
+        for (int i = 0; i < threads * names; i++) {
+            std::ostringstream name;
+            name << "Clerk " << i;
+            clerks.push_back(Bureaucrat(name.str(), 150 - i));
+        }
+        roster.insert(boss);
+        for (int t = 0; t < threads; t++) {
+            workers[t].roster = &roster;
+            workers[t].clerks = &clerks[t * names];
+            workers[t].count = names;
+            workers[t].errors = 0;
+            pthread_create(&ids[t], NULL, rosterWorker, &workers[t]);
+        }
+        int errors = 0;
+        for (int t = 0; t < threads; t++) {
+            pthread_join(ids[t], NULL);
+            errors += workers[t].errors;
+        }
+        std::cout << "Wrong lookups: " << errors << ", size: " << roster.getSize()
+                  << ", Boss found: " << (roster.find("Boss") == &boss ? "yes" : "no") << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+}
+
+void testPermissionMatrix() {
+    std::cout << "\n========== PERMISSION MATRIX ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Single queries ---" << std::endl;
+        PermissionMatrix matrix = PermissionMatrix::standard();
+        std::cout << "Grade 72 can sign robotomy: "
+                  << (matrix.canSign(72, Intern::ROBOTOMY_REQUEST) ? "yes" : "no") << std::endl;
+        std::cout << "Grade 73 can sign robotomy: "
+                  << (matrix.canSign(73, Intern::ROBOTOMY_REQUEST) ? "yes" : "no") << std::endl;
+        std::cout << "Grade 5 can execute pardon: "
+                  << (matrix.canExecute(5, Intern::PRESIDENTIAL_PARDON) ? "yes" : "no") << std::endl;
+        
+        std::cout << "\n--- Test 2: Batch query ---" << std::endl;
+        int grades[] = {150, 137, 45, 6, 0};
+        int types[] = {
+            Intern::SHRUBBERY_CREATION, Intern::SHRUBBERY_CREATION,
+            Intern::ROBOTOMY_REQUEST, Intern::PRESIDENTIAL_PARDON, Intern::PRESIDENTIAL_PARDON
+        };
+        bool allowed[5];
+        matrix.canExecute(grades, types, 5, allowed);
+        for (int i = 0; i < 5; i++)
+            std::cout << "grade " << grades[i] << " executes " << Intern::getFormTypeName(types[i])
+                      << ": " << (allowed[i] ? "yes" : "no") << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+}
+
+// True when second did not run, or finished after first
+static bool finishedBefore(const FormGraph &graph, size_t first, size_t second) {
+    const std::vector<size_t> &order = graph.getCompletionOrder();
+    std::vector<size_t>::const_iterator firstAt = std::find(order.begin(), order.end(), first);
+    std::vector<size_t>::const_iterator secondAt = std::find(order.begin(), order.end(), second);
+    
+    if (secondAt == order.end())
+        return true;
+    return firstAt < secondAt && graph.getState(first) == FormGraph::SUCCEEDED;
+}
+
+void testFormGraph() {
+    std::cout << "\n========== FORM DEPENDENCY GRAPH ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: Pardon only after a successful robotomy ---" << std::endl;
+        FormGraph graph;
+        Bureaucrat boss("Boss", 1);
+        ShrubberyCreationForm garden("garden");
+        RobotomyRequestForm robotomy("Marvin");
+        PresidentialPardonForm pardon("Marvin");
+        ShrubberyCreationForm office("office");  // Never signed: fails
+        PresidentialPardonForm blocked("Trillian");
+        
+        boss.signForm(garden);
+        boss.signForm(robotomy);
+        boss.signForm(pardon);
+        boss.signForm(blocked);
+        size_t gardenNode = graph.addForm(garden);
+        size_t robotomyNode = graph.addForm(robotomy);
+        size_t pardonNode = graph.addForm(pardon);
+        size_t officeNode = graph.addForm(office);
+        size_t blockedNode = graph.addForm(blocked);
+        graph.addDependency(robotomyNode, gardenNode);
+        graph.addDependency(pardonNode, robotomyNode);
+        graph.addDependency(blockedNode, officeNode);
+        
+        graph.run(boss);
+        std::cout << graph << std::endl;
+        std::cout << "Dependencies finished first: "
+                  << (finishedBefore(graph, gardenNode, robotomyNode)
+                      && finishedBefore(graph, robotomyNode, pardonNode) ? "yes" : "no") << std::endl;
+        std::cout << "Blocked pardon cancelled: "
+                  << (graph.getState(blockedNode) == FormGraph::CANCELLED ? "yes" : "no") << std::endl;
+        
+        std::cout << "\n--- Test 2: Cycle ---" << std::endl;
+        graph.addDependency(gardenNode, pardonNode);
+        graph.run(boss);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+void testSignatureQuorum() {
+    std::cout << "\n========== MULTI-SIGNATURE FORMS ==========" << std::endl;
+    
+    try {
+        std::cout << "\n--- Test 1: 3 of 5 signatures for a pardon ---" << std::endl;
+        Bureaucrat alice("Alice", 10);
+        Bureaucrat bob("Bob", 20);
+        Bureaucrat carol("Carol", 5);
+        Bureaucrat intern("Intern", 120);
+        PresidentialPardonForm pardon("Arthur Dent");
+        std::vector<std::string> signers;
+        signers.push_back("Alice");
+        signers.push_back("Bob");
+        signers.push_back("Carol");
+        signers.push_back("Dave");
+        signers.push_back("Intern");
+        SignatureQuorum quorum(pardon, signers, 3, 20);
+        
+        quorum.sign(0, alice);
+        quorum.sign(0, alice);  // Repeated signature: ignored
+        try {
+            quorum.sign(3, alice);  // Dave's seat
+        }
+        catch (std::exception &e) {
+            std::cout << "Alice on a second seat: " << e.what() << std::endl;
+        }
+        std::cout << "Signatures after Alice signed twice: " << quorum.getSignatureCount() << std::endl;
+        quorum.sign(1, bob);
+        std::cout << quorum << std::endl;
+        std::cout << "Pardon signed: " << (pardon.getIsSigned() ? "yes" : "no") << std::endl;
+        carol.signForm(pardon);  // A single signature cannot bypass the quorum
+        std::cout << "Pardon signed: " << (pardon.getIsSigned() ? "yes" : "no") << std::endl;
+        std::cout << "Carol completes the quorum: "
+                  << (quorum.sign(2, carol) ? "yes" : "no") << std::endl;
+        std::cout << quorum << std::endl;
+        carol.executeForm(pardon);
+        
+        std::cout << "\n--- Test 2: Signer below the minimum grade ---" << std::endl;
+        quorum.sign(4, intern);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+    
+    try {
+        std::cout << "\n--- Test 3: Quorum larger than the signers ---" << std::endl;
+        ShrubberyCreationForm garden("garden");
+        std::vector<std::string> signers(2, "Alice");
+        signers[1] = "Bob";
+        SignatureQuorum quorum(garden, signers, 3, 100);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+    
+    try {
+        std::cout << "\n--- Test 4: One signer on two seats ---" << std::endl;
+        ShrubberyCreationForm garden("garden");
+        std::vector<std::string> signers(2, "Alice");
+        SignatureQuorum quorum(garden, signers, 2, 100);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+void testBatchSigning() {
+    std::cout << "\n========== TRANSACTIONAL BATCH SIGNING ==========" << std::endl;
+    
+    try {
+        Bureaucrat clerk("Clerk", 70);
+        ShrubberyCreationForm garden("garden");
+        RobotomyRequestForm robotomy("Bender");
+        PresidentialPardonForm pardon("Ford Prefect");
+        std::vector<AForm *> batch;
+        std::vector<std::string> reasons;
+        
+        std::cout << "\n--- Test 1: One form out of reach rejects the batch ---" << std::endl;
+        batch.push_back(&garden);
+        batch.push_back(&robotomy);
+        batch.push_back(&pardon);
+        clerk.signForms(batch, reasons);
+        for (size_t i = 0; i < reasons.size(); i++)
+            std::cout << "  " << reasons[i] << std::endl;
+        std::cout << "Garden signed: " << (garden.getIsSigned() ? "yes" : "no") << std::endl;
+        
+        std::cout << "\n--- Test 2: The rest of the batch signs together ---" << std::endl;
+        batch.pop_back();
+        clerk.signForms(batch, reasons);
+        std::cout << "Garden signed: " << (garden.getIsSigned() ? "yes" : "no")
+                  << ", robotomy signed: " << (robotomy.getIsSigned() ? "yes" : "no") << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+void testPackedRoster() {
+    std::cout << "\n========== BULK GRADE UPDATES ==========" << std::endl;
+    
+    try {
+        PackedRoster roster;
+        std::vector<int> deltas;
+        std::vector<PackedRoster::GradeError> errors;
+        
+        roster.add("Alice", 3);
+        roster.add("Bob", 75);
+        roster.add("Carol", 148);
+        roster.add("Dave", 75);
+        
+        std::cout << "\n--- Test 1: Annual review ---" << std::endl;
+        deltas.push_back(5);    // Alice: promoted past grade 1
+        deltas.push_back(10);   // Bob: promoted
+        deltas.push_back(-5);   // Carol: demoted past grade 150
+        deltas.push_back(0);    // Dave: unchanged
+        std::cout << roster.applyDeltas(deltas, errors) << " grades changed" << std::endl;
+        std::cout << roster << std::endl;
+        for (size_t i = 0; i < errors.size(); i++)
+            std::cout << "  Saturated: " << roster.getName(errors[i].index) << ", grade "
+                      << errors[i].grade << " with delta " << errors[i].delta << std::endl;
+        std::cout << "At grade 75: " << roster.countAtGrade(75)
+                  << ", at grade 65 or better: " << roster.countAtOrAbove(65) << std::endl;
+        
+        std::cout << "\n--- Test 2: Wrong number of deltas ---" << std::endl;
+        deltas.pop_back();
+        roster.applyDeltas(deltas, errors);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+void testFormIndex() {
+    std::cout << "\n========== FORM INDEX ==========" << std::endl;
+    
+    try {
+        Bureaucrat bob("Bob", 50);
+        Bureaucrat boss("Boss", 1);
+        ShrubberyCreationForm garden("garden");
+        ShrubberyCreationForm park("park");
+        RobotomyRequestForm robotomy("Bender");
+        PresidentialPardonForm pardon("Ford Prefect");
+        std::vector<AForm *> forms;
+        
+        boss.signForm(park);
+        boss.signForm(robotomy);
+        forms.push_back(&garden);
+        forms.push_back(&park);
+        forms.push_back(&robotomy);
+        forms.push_back(&pardon);
+        
+        FormIndex index(forms);
+        std::cout << "\n--- Test 1: What can Bob act on? ---" << std::endl;
+        std::cout << "Bob can sign " << index.signableBy(bob) << std::endl;
+        std::cout << "Bob can execute " << index.executableBy(bob) << std::endl;
+        
+        std::cout << "\n--- Test 2: After Bob signs, rebuild ---" << std::endl;
+        for (FormIndex::const_iterator it = index.signableBy(bob).begin();
+             it != index.signableBy(bob).end(); ++it)
+            bob.signForm(**it);
+        index.rebuild(forms);
+        std::cout << "Bob can sign " << index.signableBy(bob) << std::endl;
+        std::cout << "Boss can execute " << index.executableBy(boss) << std::endl;
+        
+        std::cout << "\n--- Test 3: Invalid grade ---" << std::endl;
+        index.signableBy(151);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+void testFormTypeRegistry() {
+    std::cout << "\n========== FORM TYPE CONFIGURATION ==========" << std::endl;
+    
+    EpochReclaimer reclaimer;
+    FormTypeRegistry registry(reclaimer);
+    int slot = reclaimer.registerReader();
+    Bureaucrat bob("Bob", 60);
+    
+    try {
+        std::cout << "\n--- Test 1: Compiled-in form types ---" << std::endl;
+        std::cout << registry.getSnapshot(slot) << std::endl;
+        
+        std::cout << "\n--- Test 2: Reload with a lenient robotomy ---" << std::endl;
+        std::istringstream config(
+            "# Robotomies are now routine\n"
+            "RobotomyRequestForm 100 60 routine robotomy\n");
+        registry.load(config);
+        std::cout << registry.getSnapshot(slot) << std::endl;
+        AForm *robotomy = registry.makeForm(slot, "routine robotomy", "Bender");
+        bob.signForm(*robotomy);
+        bob.executeForm(*robotomy);
+        FormRecord record = ShardedExecutor::makeRecord(*robotomy, 60, 60);
+        std::cout << "Sharded record grades: " << static_cast<int>(record.grade_to_sign)
+                  << "/" << static_cast<int>(record.grade_to_execute) << std::endl;
+        delete robotomy;
+        FormDescriptor descriptor = registry.makeFormDescriptor(slot, "routine robotomy", "Marvin");
+        bob.signForm(descriptor);
+        std::cout << "Grade 60 may execute it: "
+                  << (registry.makePermissionMatrix(slot).canExecute(60, Intern::ROBOTOMY_REQUEST)
+                      ? "yes" : "no") << std::endl;
+        size_t reclaimed = 0;
+        for (int epoch = 0; epoch < 3; epoch++)
+            reclaimed += reclaimer.tryReclaim();
+        std::cout << "Old snapshots reclaimed: " << reclaimed << std::endl;
+        
+        std::cout << "\n--- Test 3: Invalid configuration keeps the current one ---" << std::endl;
+        std::istringstream broken("PresidentialPardonForm 0 5\n");
+        try {
+            registry.load(broken);
+        }
+        catch (std::exception &e) {
+            std::cerr << "Caught exception: " << e.what() << std::endl;
+        }
+        std::cout << "Still at version " << registry.getVersion(slot) << std::endl;
+        std::istringstream clash(
+            "ShrubberyCreationForm 145 137 pardon\n"
+            "PresidentialPardonForm 25 5 pardon\n");
+        try {
+            registry.load(clash);
+        }
+        catch (std::exception &e) {
+            std::cerr << "Caught exception: " << e.what() << std::endl;
+        }
+        std::cout << "Still at version " << registry.getVersion(slot) << std::endl;
+        
+        std::cout << "\n--- Test 4: Unknown name ---" << std::endl;
+        registry.makeForm(slot, "robotomy request", "Bender");
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+    
+    try {
+        std::cout << "\n--- Test 5: Two types trade names ---" << std::endl;
+        std::istringstream swapped(
+            "ShrubberyCreationForm 145 137 presidential pardon\n"
+            "PresidentialPardonForm 25 5 shrubbery creation\n");
+        registry.load(swapped);
+        std::cout << registry.getSnapshot(slot) << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+    reclaimer.unregisterReader(slot);
+}
+
+void testFormDescriptors() {
+    std::cout << "\n========== LAZY FORM DESCRIPTORS ==========" << std::endl;
+    
+    try {
+        Intern intern;
+        Bureaucrat clerk("Clerk", 100);
+        Bureaucrat boss("Boss", 1);
+        std::vector<FormDescriptor> queue;
+        
+        std::cout << "\n--- Test 1: Queue of descriptors (" << sizeof(FormDescriptor)
+                  << " bytes each) ---" << std::endl;
+        queue.push_back(intern.makeFormDescriptor("robotomy request", "Bender"));
+        queue.push_back(intern.makeFormDescriptor("presidential pardon", "Arthur Dent"));
+        queue.push_back(intern.makeFormDescriptor("robotomy request", "Bender"));
+        std::cout << queue[0] << std::endl;
+        std::cout << "Same target, same handle: "
+                  << (queue[0].target == queue[2].target ? "yes" : "no") << std::endl;
+        
+        std::cout << "\n--- Test 2: Rejected at signing, nothing materialized ---" << std::endl;
+        clerk.signForm(queue[1]);
+        clerk.executeForm(queue[1]);
+        
+        std::cout << "\n--- Test 3: Materialized on execution ---" << std::endl;
+        boss.signForm(queue[1]);
+        boss.executeForm(queue[1]);
+        
+        std::cout << "\n--- Test 4: Unknown form type ---" << std::endl;
+        intern.makeFormDescriptor("coffee request", "Boss");
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+void testTargetPool() {
+    std::cout << "\n========== TARGET POOL ==========" << std::endl;
+    
+    try {
+        std::string employee(200, 'x');
+        ShrubberyCreationForm home("home");
+        ShrubberyCreationForm garden("garden");
+        RobotomyRequestForm robotomy(employee);
+        PresidentialPardonForm pardon(employee);
+        
+        std::cout << "\n--- Test 1: Forms share their targets ---" << std::endl;
+        size_t pooled = TargetPool::getSize();
+        ShrubberyCreationForm home_copy(home);
+        ShrubberyCreationForm home_again("home");
+        std::cout << "New pool entries: " << TargetPool::getSize() - pooled << std::endl;
+        std::cout << "Same target string: "
+                  << (&robotomy.getTarget() == &pardon.getTarget() ? "yes" : "no") << std::endl;
+        std::cout << "Form size with a 200 character target: " << sizeof(robotomy)
+                  << " bytes, with \"home\": " << sizeof(home) << " bytes" << std::endl;
+        
+        std::cout << "\n--- Test 2: Swap exchanges handles ---" << std::endl;
+        home.swap(garden);
+        std::cout << home.getTarget() << " / " << garden.getTarget() << std::endl;
+        
+        std::cout << "\n--- Test 3: Unknown handle ---" << std::endl;
+        TargetPool::get(static_cast<TargetPool::Handle>(TargetPool::getSize()));
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+}
+
+void testFormBatch() {
+    std::cout << "\n========== BULK FORM CREATION ==========" << std::endl;
+    
+    Intern intern;
+    Bureaucrat boss("Boss", 1);
+    FormBatch batch;
+    std::vector<std::string> names;
+    std::vector<std::string> targets;
+    
+    try {
+        std::cout << "\n--- Test 1: One allocation for the whole batch ---" << std::endl;
+        names.push_back("presidential pardon");
+        targets.push_back("Arthur Dent");
+        names.push_back("robotomy request");
+        targets.push_back("Bender");
+        names.push_back("presidential pardon");
+        targets.push_back("Ford Prefect");
+        intern.makeForms(names, targets, batch);
+        std::cout << batch << std::endl;
+        std::cout << "Pardons stored next to each other: "
+                  << (reinterpret_cast<char *>(&batch[2]) - reinterpret_cast<char *>(&batch[0])
+                      == static_cast<long>(sizeof(PresidentialPardonForm)) ? "yes" : "no")
+                  << std::endl;
+        for (FormBatch::const_iterator it = batch.begin(); it != batch.end(); ++it)
+            boss.signForm(**it);
+        boss.executeForm(batch[2]);
+        
+        std::cout << "\n--- Test 2: Batch forms cannot be owned by a handle ---" << std::endl;
+        try {
+            FormHandle owner(&batch[0]);
+        }
+        catch (std::exception &e) {
+            std::cout << "FormHandle refused: " << e.what() << std::endl;
+        }
+        
+        std::cout << "\n--- Test 3: Unknown name, nothing is created ---" << std::endl;
+        names.push_back("coffee request");
+        targets.push_back("Boss");
+        intern.makeForms(names, targets, batch);
+    }
+    catch (std::exception &e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+    }
+    std::cout << "Batch still holds " << batch.size() << " forms" << std::endl;
+}
+
 int main(void) {
     testExampleFromSubject();
     testInternCreation();
     testInvalidForms();
     testMultipleForms();
     testInternCopy();
+    testFormAssignment();
     testEdgeCases();
+    testRobotomySimulation();
+    testAsyncExecution();
+    testExecutionCache();
+    testFormScheduler();
+    testShardedExecutor();
+    testFormProtocol();
+    testWorkloadGenerator();
+    testSnapshot();
+    testReportWriter();
+    testOutcomeAggregator();
+    testFormHandles();
+    testEpochReclaimer();
+    testRosterMap();
+    testPermissionMatrix();
+    testFormGraph();
+    testSignatureQuorum();
+    testBatchSigning();
+    testPackedRoster();
+    testFormIndex();
+    testFormTypeRegistry();
+    testFormDescriptors();
+    testTargetPool();
+    testFormBatch();
     
     std::cout << "\n========== ALL TESTS COMPLETED ==========" << std::endl;
     return 0;